@@ -10,6 +10,7 @@
 #include <auth_mod.h>
 #include <bl1.h>
 #include <bl_common.h>
+#include <boot_timeline.h>
 #include <console.h>
 #include <debug.h>
 #include <errata_report.h>
@@ -57,6 +58,11 @@ void bl1_main(void)
 {
 	unsigned int image_id;
 
+#if ENABLE_BOOT_TIMELINE
+	boot_timeline_init();
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL1_ENTRY);
+#endif
+
 	/* Announce our arrival */
 	NOTICE(FIRMWARE_WELCOME_STR);
 	NOTICE("BL1: %s\n", version_string);
@@ -121,6 +127,8 @@ void bl1_main(void)
 
 	bl1_prepare_next_image(image_id);
 
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL1_EXIT);
+
 	console_flush();
 }
 
@@ -156,6 +164,9 @@ static void bl1_load_bl2(void)
 		plat_error_handler(err);
 	}
 
+	/* BL1 does not load any other image, release the IO devices */
+	close_image_devices();
+
 	/* Allow platform to handle image information. */
 	err = bl1_plat_handle_post_image_load(BL2_IMAGE_ID);
 	if (err) {
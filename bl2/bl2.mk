@@ -7,9 +7,16 @@
 BL2_SOURCES		+=	bl2/bl2_main.c				\
 				bl2/${ARCH}/bl2_arch_setup.c		\
 				lib/locks/exclusive/${ARCH}/spinlock.S	\
-				plat/common/${ARCH}/platform_up_stack.S	\
 				${MBEDTLS_SOURCES}
 
+ifeq (${BL2_PARALLEL_WORK},1)
+BL2_SOURCES		+=	bl2/bl2_work.c				\
+				bl2/${ARCH}/bl2_work_entrypoint.S	\
+				plat/common/${ARCH}/platform_mp_stack.S
+else
+BL2_SOURCES		+=	plat/common/${ARCH}/platform_up_stack.S
+endif
+
 ifeq (${ARCH},aarch64)
 BL2_SOURCES		+=	common/aarch64/early_exceptions.S
 endif
@@ -9,6 +9,8 @@
 #include <assert.h>
 #include <auth_mod.h>
 #include <bl_common.h>
+#include <boot_timeline.h>
+#include <bl2_work.h>
 #include <debug.h>
 #include <desc_image_load.h>
 #include <platform.h>
@@ -39,6 +41,11 @@ struct entry_point_info *bl2_load_images(void)
 	assert(bl2_load_info->h.version >= VERSION_2);
 	bl2_node_info = bl2_load_info->head;
 
+#if BL2_PARALLEL_WORK
+	/* Let the secondary cores pick up work deferred while loading */
+	bl2_work_start();
+#endif
+
 	while (bl2_node_info) {
 		/*
 		 * Perform platform setup before loading the image,
@@ -74,16 +81,41 @@ struct entry_point_info *bl2_load_images(void)
 		}
 
 		/* Allow platform to handle image information. */
+		BOOT_TIMELINE_CAPTURE_IMAGE(bl2_node_info->image_id,
+					    BOOT_TIMELINE_IMG_POST_START);
 		err = bl2_plat_handle_post_image_load(bl2_node_info->image_id);
+		BOOT_TIMELINE_CAPTURE_IMAGE(bl2_node_info->image_id,
+					    BOOT_TIMELINE_IMG_POST_END);
 		if (err) {
 			ERROR("BL2: Failure in post image load handling (%i)\n", err);
 			plat_error_handler(err);
 		}
 
+#if BL2_PARALLEL_WORK
+		/* Stop as soon as work deferred for an earlier image has failed */
+		err = bl2_work_error();
+		if (err) {
+			ERROR("BL2: Failure in deferred image work (%i)\n", err);
+			plat_error_handler(err);
+		}
+#endif
+
 		/* Go to next image */
 		bl2_node_info = bl2_node_info->next_load_info;
 	}
 
+#if BL2_PARALLEL_WORK
+	/* Wait for the work deferred while loading the images */
+	err = bl2_work_finish();
+	if (err) {
+		ERROR("BL2: Failure in deferred image work (%i)\n", err);
+		plat_error_handler(err);
+	}
+#endif
+
+	/* All images are loaded, release the IO devices */
+	close_image_devices();
+
 	/*
 	 * Get information to pass to the next image.
 	 */
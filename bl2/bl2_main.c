@@ -9,6 +9,7 @@
 #include <bl1.h>
 #include <bl2.h>
 #include <bl_common.h>
+#include <boot_timeline.h>
 #include <console.h>
 #include <debug.h>
 #include <platform.h>
@@ -29,6 +30,11 @@ void bl2_main(void)
 {
 	entry_point_info_t *next_bl_ep_info;
 
+#if ENABLE_BOOT_TIMELINE && BL2_AT_EL3
+	boot_timeline_init();
+#endif
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL2_ENTRY);
+
 	NOTICE("BL2: %s\n", version_string);
 	NOTICE("BL2: %s\n", build_message);
 
@@ -46,6 +52,8 @@ void bl2_main(void)
 	/* Load the subsequent bootloader images. */
 	next_bl_ep_info = bl2_load_images();
 
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL2_EXIT);
+
 #if !BL2_AT_EL3
 #ifdef AARCH32
 	/*
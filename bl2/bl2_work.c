@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <bl2_work.h>
+#include <debug.h>
+#include <platform.h>
+#include <platform_def.h>
+#include <spinlock.h>
+#include <xlat_mmu_helpers.h>
+
+/*
+ * Maximum number of work items that can be queued but not yet started. When
+ * the queue is full, the submitting core runs queued work itself until a slot
+ * becomes free.
+ */
+#ifndef PLAT_BL2_WORK_QUEUE_SIZE
+# define PLAT_BL2_WORK_QUEUE_SIZE	8
+#endif
+
+static spinlock_t work_lock;
+
+/*
+ * Serialises the log output of the cores running BL2 work. It is only taken
+ * once the secondary cores are released, when the MMU is enabled.
+ */
+static spinlock_t console_lock;
+
+/* Work items not started yet, in submission order */
+static bl2_work_t *work_queue[PLAT_BL2_WORK_QUEUE_SIZE];
+static unsigned int work_queued;
+
+/* Number of submitted work items that are not done yet */
+static unsigned int work_pending;
+
+/* Error returned by the first failing work item since the last barrier */
+static int work_error;
+
+/* Number of secondary cores still running the work loop */
+static unsigned int secondaries_active;
+static unsigned int work_started;
+static unsigned int work_stopping;
+
+/*******************************************************************************
+ * Remove the oldest queued work item that may be started from the queue and
+ * mark it as running. Return NULL if no such work item exists.
+ ******************************************************************************/
+static bl2_work_t *take_work(void)
+{
+	bl2_work_t *work = NULL;
+	unsigned int i;
+
+	spin_lock(&work_lock);
+
+	for (i = 0U; i < work_queued; i++) {
+		const bl2_work_t *after = work_queue[i]->after;
+
+		if ((after == NULL) || (after->state == BL2_WORK_DONE)) {
+			work = work_queue[i];
+			break;
+		}
+	}
+
+	if (work != NULL) {
+		for (; i < (work_queued - 1U); i++)
+			work_queue[i] = work_queue[i + 1U];
+		work_queued--;
+		work->state = BL2_WORK_RUNNING;
+	}
+
+	spin_unlock(&work_lock);
+
+	return work;
+}
+
+static void run_work(bl2_work_t *work)
+{
+	int ret = work->func(work->arg);
+
+	spin_lock(&work_lock);
+	work->ret = ret;
+	work->state = BL2_WORK_DONE;
+	work_pending--;
+	if ((ret != 0) && (work_error == 0))
+		work_error = ret;
+	spin_unlock(&work_lock);
+
+	/* Wake up the cores waiting for this work item */
+	dsbish();
+	sev();
+}
+
+/*******************************************************************************
+ * Run one queued work item on the calling core, or wait for an event if none
+ * may be started at the moment.
+ ******************************************************************************/
+static void help_work(void)
+{
+	bl2_work_t *work = take_work();
+
+	if (work != NULL)
+		run_work(work);
+	else
+		wfe();
+}
+
+/*******************************************************************************
+ * Release the secondary cores into the work loop. The platform decides which
+ * cores, if any, take part. Without secondary cores, all work is run on the
+ * primary core while it waits for the work to be done.
+ ******************************************************************************/
+void bl2_work_start(void)
+{
+	unsigned int count;
+
+	assert(work_started == 0U);
+	work_started = 1U;
+
+	count = plat_bl2_wake_secondaries((uintptr_t)bl2_work_entrypoint);
+
+	/*
+	 * Account for the released cores now so that bl2_work_finish() waits
+	 * for them even if they have not reached the work loop yet.
+	 */
+	spin_lock(&work_lock);
+	secondaries_active += count;
+	spin_unlock(&work_lock);
+
+	INFO("BL2: %u secondary cores running work\n", count);
+}
+
+/*******************************************************************************
+ * Queue `work` to call `func(arg)` once `after`, if not NULL, is done.
+ ******************************************************************************/
+void bl2_work_submit(bl2_work_t *work, bl2_work_func_t func, void *arg,
+		     const bl2_work_t *after)
+{
+	assert(work != NULL);
+	assert(func != NULL);
+	assert((work->state == BL2_WORK_IDLE) ||
+	       (work->state == BL2_WORK_DONE));
+	assert((after == NULL) || (after->state != BL2_WORK_IDLE));
+
+	work->func = func;
+	work->arg = arg;
+	work->after = after;
+	work->ret = 0;
+
+	spin_lock(&work_lock);
+
+	while (work_queued == PLAT_BL2_WORK_QUEUE_SIZE) {
+		spin_unlock(&work_lock);
+		help_work();
+		spin_lock(&work_lock);
+	}
+
+	work->state = BL2_WORK_QUEUED;
+	work_queue[work_queued] = work;
+	work_queued++;
+	work_pending++;
+
+	spin_unlock(&work_lock);
+
+	dsbish();
+	sev();
+}
+
+/*******************************************************************************
+ * Wait until `work` is done and return its result. The calling core runs
+ * queued work while it waits. Returns immediately for a work item that has
+ * never been submitted.
+ ******************************************************************************/
+int bl2_work_wait(bl2_work_t *work)
+{
+	unsigned int state;
+	int ret;
+
+	assert(work != NULL);
+
+	for (;;) {
+		spin_lock(&work_lock);
+		state = work->state;
+		ret = work->ret;
+		spin_unlock(&work_lock);
+
+		if ((state == BL2_WORK_IDLE) || (state == BL2_WORK_DONE))
+			return ret;
+
+		help_work();
+	}
+}
+
+/*******************************************************************************
+ * Wait until all submitted work is done. Returns the error of the first work
+ * item that failed since the previous barrier, or 0.
+ ******************************************************************************/
+int bl2_work_barrier(void)
+{
+	unsigned int pending;
+	int ret;
+
+	for (;;) {
+		spin_lock(&work_lock);
+		pending = work_pending;
+		ret = work_error;
+		if (pending == 0U)
+			work_error = 0;
+		spin_unlock(&work_lock);
+
+		if (pending == 0U)
+			return ret;
+
+		help_work();
+	}
+}
+
+/*******************************************************************************
+ * Return the error of the first work item that failed since the previous
+ * barrier, or 0, without waiting for the work that is not done yet. This lets
+ * BL2 stop loading images as soon as deferred work has failed.
+ ******************************************************************************/
+int bl2_work_error(void)
+{
+	int ret;
+
+	spin_lock(&work_lock);
+	ret = work_error;
+	spin_unlock(&work_lock);
+
+	return ret;
+}
+
+/*******************************************************************************
+ * Take and release the lock of the console, used by tf_log() so that the
+ * messages of the cores running BL2 work are not interleaved.
+ ******************************************************************************/
+void bl2_work_console_lock(void)
+{
+	if (work_started != 0U)
+		spin_lock(&console_lock);
+}
+
+void bl2_work_console_unlock(void)
+{
+	if (work_started != 0U)
+		spin_unlock(&console_lock);
+}
+
+/*******************************************************************************
+ * Wait until all submitted work is done and return the secondary cores to the
+ * platform. No work may be submitted afterwards. This must be called before
+ * BL2 hands off to the next image.
+ ******************************************************************************/
+int bl2_work_finish(void)
+{
+	unsigned int active;
+	int ret;
+
+	ret = bl2_work_barrier();
+
+	if (work_started == 0U)
+		return ret;
+
+	spin_lock(&work_lock);
+	work_stopping = 1U;
+	spin_unlock(&work_lock);
+
+	dsbish();
+	sev();
+
+	do {
+		spin_lock(&work_lock);
+		active = secondaries_active;
+		spin_unlock(&work_lock);
+
+		if (active != 0U)
+			wfe();
+	} while (active != 0U);
+
+	work_started = 0U;
+
+	return ret;
+}
+
+/*******************************************************************************
+ * Main function of the secondary cores, called by bl2_work_entrypoint() with
+ * the MMU disabled and a stack set up.
+ ******************************************************************************/
+void bl2_work_secondary_main(void)
+{
+	unsigned int stopping;
+	bl2_work_t *work;
+
+	/* Use the translation tables already set up by the primary core */
+#if BL2_AT_EL3
+	enable_mmu_el3(0U);
+#else
+	enable_mmu_el1(0U);
+#endif
+
+	VERBOSE("BL2: core 0x%lx running work\n", read_mpidr());
+
+	for (;;) {
+		work = take_work();
+		if (work != NULL) {
+			run_work(work);
+			continue;
+		}
+
+		spin_lock(&work_lock);
+		stopping = work_stopping;
+		spin_unlock(&work_lock);
+
+		if (stopping != 0U)
+			break;
+
+		wfe();
+	}
+
+	spin_lock(&work_lock);
+	secondaries_active--;
+	spin_unlock(&work_lock);
+
+	dsbish();
+	sev();
+
+	/*
+	 * Turn the MMU and caches off and clean this core's caches, so that no
+	 * dirty line of BL2 memory is left behind once the next image reuses
+	 * it.
+	 */
+#if BL2_AT_EL3
+	disable_mmu_icache_el3();
+#else
+	disable_mmu_icache_el1();
+#endif
+	dcsw_op_louis(DCCISW);
+
+	plat_bl2_park_secondary();
+}
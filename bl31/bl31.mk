@@ -36,6 +36,19 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_RUNTIME_STATS},1)
+BL31_SOURCES		+=	bl31/runtime_stats.c
+endif
+
+ifeq (${ENABLE_SMC_BENCHMARK},1)
+# The benchmark service owns the OEM service call range, which the MediaTek
+# platforms already use for their OEM service.
+ifneq ($(filter %/oem_svc.c,${BL31_SOURCES}),)
+$(error ENABLE_SMC_BENCHMARK cannot be used with a platform OEM service)
+endif
+BL31_SOURCES		+=	services/smc_bench/smc_bench.c
+endif
+
 ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <bl31.h>
 #include <bl_common.h>
+#include <boot_timeline.h>
 #include <console.h>
 #include <context_mgmt.h>
 #include <debug.h>
@@ -23,6 +24,8 @@
 #if ENABLE_RUNTIME_INSTRUMENTATION
 PMF_REGISTER_SERVICE_SMC(rt_instr_svc, PMF_RT_INSTR_SVC_ID,
 	RT_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+PMF_REGISTER_SERVICE_SMC(rt_instr_ctx_svc, PMF_RT_INSTR_CTX_SVC_ID,
+	RT_INSTR_CTX_TOTAL_IDS, PMF_STORE_ENABLE)
 #endif
 
 /*******************************************************************************
@@ -72,6 +75,11 @@ void bl31_lib_init(void)
  ******************************************************************************/
 void bl31_main(void)
 {
+#if ENABLE_BOOT_TIMELINE && RESET_TO_BL31
+	boot_timeline_init();
+#endif
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL31_ENTRY);
+
 	NOTICE("BL31: %s\n", version_string);
 	NOTICE("BL31: %s\n", build_message);
 
@@ -117,6 +125,11 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+#if ENABLE_BOOT_TIMELINE
+	BOOT_TIMELINE_CAPTURE(BOOT_TIMELINE_BL31_EXIT);
+	boot_timeline_print();
+#endif
+
 	console_flush();
 
 	/*
@@ -18,6 +18,7 @@
 #include <interrupt_mgmt.h>
 #include <platform.h>
 #include <pubsub_events.h>
+#include <runtime_stats.h>
 #include <stdbool.h>
 
 /* Output EHF logs as verbose */
@@ -396,6 +397,9 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	uint32_t intr_raw;
 	unsigned int intr, pri, idx;
 	ehf_handler_t handler;
+#if ENABLE_RUNTIME_STATS
+	unsigned long long start;
+#endif
 
 	/*
 	 * Top-level interrupt type handler from Interrupt Management Framework
@@ -443,7 +447,13 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	 * Call registered handler. Pass the raw interrupt value to registered
 	 * handlers.
 	 */
+#if ENABLE_RUNTIME_STATS
+	start = read_cntpct_el0();
+#endif
 	ret = handler(intr_raw, flags, handle, cookie);
+#if ENABLE_RUNTIME_STATS
+	runtime_stats_intr_id(intr, start);
+#endif
 
 	return (uint64_t) ret;
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <errno.h>
+#include <interrupt_mgmt.h>
+#include <platform.h>
+#include <platform_def.h>
+#include <runtime_stats.h>
+#include <runtime_svc.h>
+#include <smccc_helpers.h>
+
+/*
+ * Runtime statistics record, for each CPU, the number of SMCs and interrupts
+ * handled by BL31 and the time spent handling them, in system counter ticks.
+ * Like PMF time-stamps, the statistics of a CPU are in cache line aligned
+ * memory that only this CPU writes, so no lock is needed. Other CPUs may read
+ * them while they are updated, and then see the values of an entry from
+ * before and after the update.
+ *
+ * PLAT_RUNTIME_STATS_NUM_INTR is the number of interrupt IDs counted
+ * individually. EL3 interrupts with a higher ID are only counted by interrupt
+ * type.
+ */
+#ifndef PLAT_RUNTIME_STATS_NUM_INTR
+# define PLAT_RUNTIME_STATS_NUM_INTR	64
+#endif
+
+typedef struct runtime_stats_entry {
+	unsigned long long count;
+	unsigned long long ticks;
+	unsigned long long max_ticks;
+	uint32_t hist[RUNTIME_STATS_HIST_BUCKETS];
+} runtime_stats_entry_t;
+
+typedef struct runtime_stats {
+	runtime_stats_entry_t smc[MAX_RT_SVCS];
+	runtime_stats_entry_t intr_type[MAX_INTR_TYPES];
+	runtime_stats_entry_t intr_id[PLAT_RUNTIME_STATS_NUM_INTR];
+} __aligned(CACHE_WRITEBACK_GRANULE) runtime_stats_t;
+
+static runtime_stats_t runtime_stats[PLATFORM_CORE_COUNT];
+
+static void runtime_stats_update(runtime_stats_entry_t *entry,
+				 unsigned long long start)
+{
+	unsigned long long ticks = read_cntpct_el0() - start;
+	unsigned int bucket = 0U;
+
+	entry->count++;
+	entry->ticks += ticks;
+	if (ticks > entry->max_ticks)
+		entry->max_ticks = ticks;
+
+	if (ticks != 0ULL) {
+		bucket = 64U - (unsigned int)__builtin_clzll(ticks);
+		if (bucket >= RUNTIME_STATS_HIST_BUCKETS)
+			bucket = RUNTIME_STATS_HIST_BUCKETS - 1U;
+	}
+	entry->hist[bucket]++;
+}
+
+/*
+ * Account for an SMC handled by the runtime service at `index` in
+ * 'rt_svc_descs_indices', whose handler was called at time `start`.
+ */
+void runtime_stats_smc(unsigned int index, unsigned long long start)
+{
+	assert(index < MAX_RT_SVCS);
+
+	runtime_stats_update(&runtime_stats[plat_my_core_pos()].smc[index],
+			     start);
+}
+
+void runtime_stats_intr_type(unsigned int type, unsigned long long start)
+{
+	assert(type < MAX_INTR_TYPES);
+
+	runtime_stats_update(
+		&runtime_stats[plat_my_core_pos()].intr_type[type], start);
+}
+
+void runtime_stats_intr_id(unsigned int id, unsigned long long start)
+{
+	if (id >= PLAT_RUNTIME_STATS_NUM_INTR)
+		return;
+
+	runtime_stats_update(&runtime_stats[plat_my_core_pos()].intr_id[id],
+			     start);
+}
+
+/*
+ * Handle RUNTIME_STATS_SMC_GET_64 and RUNTIME_STATS_HIST_GET_64. The caller
+ * gives the MPIDR of the CPU in x1, the kind of statistics in x2 and the index
+ * of the entry in x3.
+ *
+ * For RUNTIME_STATS_SMC_GET_64, the caller gets back the number of calls or
+ * interrupts in x1, the total time in x2 and the longest time in x3, both in
+ * system counter ticks. For RUNTIME_STATS_HIST_GET_64, the caller gives the
+ * histogram bucket in x4 and gets back its count in x1.
+ */
+uintptr_t runtime_stats_smc_handler(uint32_t smc_fid,
+				    u_register_t x1,
+				    u_register_t x2,
+				    u_register_t x3,
+				    u_register_t x4,
+				    void *cookie,
+				    void *handle,
+				    u_register_t flags)
+{
+	const runtime_stats_t *stats;
+	const runtime_stats_entry_t *entry;
+	int cpu;
+
+	if ((smc_fid != RUNTIME_STATS_SMC_GET_64) &&
+	    (smc_fid != RUNTIME_STATS_HIST_GET_64))
+		SMC_RET1(handle, SMC_UNK);
+
+	cpu = plat_core_pos_by_mpidr(x1);
+	if (cpu < 0)
+		SMC_RET1(handle, -EINVAL);
+
+	stats = &runtime_stats[cpu];
+
+	switch (x2) {
+	case RUNTIME_STATS_SMC:
+		if (x3 >= MAX_RT_SVCS)
+			SMC_RET1(handle, -EINVAL);
+		entry = &stats->smc[x3];
+		break;
+	case RUNTIME_STATS_INTR_TYPE:
+		if (x3 >= MAX_INTR_TYPES)
+			SMC_RET1(handle, -EINVAL);
+		entry = &stats->intr_type[x3];
+		break;
+	case RUNTIME_STATS_INTR_ID:
+		if (x3 >= PLAT_RUNTIME_STATS_NUM_INTR)
+			SMC_RET1(handle, -EINVAL);
+		entry = &stats->intr_id[x3];
+		break;
+	default:
+		SMC_RET1(handle, -EINVAL);
+	}
+
+	if (smc_fid == RUNTIME_STATS_HIST_GET_64) {
+		if (x4 >= RUNTIME_STATS_HIST_BUCKETS)
+			SMC_RET1(handle, -EINVAL);
+		SMC_RET2(handle, SMC_OK, entry->hist[x4]);
+	}
+
+	SMC_RET4(handle, SMC_OK, entry->count, entry->ticks, entry->max_ticks);
+}
@@ -9,10 +9,12 @@
 #include <assert.h>
 #include <auth_mod.h>
 #include <bl_common.h>
+#include <boot_timeline.h>
 #include <debug.h>
 #include <errno.h>
 #include <io_storage.h>
 #include <platform.h>
+#include <platform_def.h>
 #include <string.h>
 #include <utils.h>
 #include <xlat_tables_defs.h>
@@ -45,6 +47,77 @@ static int dyn_is_auth_disabled(void)
 }
 #endif /* TRUSTED_BOARD_BOOT */
 
+#if TRUSTED_BOARD_BOOT && AUTH_STREAM_HASH
+/*
+ * Size of the blocks in which images authenticated while being loaded are read
+ * and hashed. It should be small enough for a block to still be in the data
+ * cache when it is hashed.
+ */
+#ifndef PLAT_AUTH_STREAM_CHUNK_SIZE
+#define PLAT_AUTH_STREAM_CHUNK_SIZE	U(0x8000)
+#endif
+#endif
+
+#if KEEP_IO_DEV_OPEN
+/*
+ * Device connections used to load images in this boot stage. They are kept
+ * open between images and only closed by close_image_devices().
+ */
+static uintptr_t open_image_devs[MAX_IO_DEVICES];
+#endif
+
+/******************************************************************************
+ * Release a device connection once an image has been accessed through it. If
+ * KEEP_IO_DEV_OPEN is set and the access succeeded, the connection is kept
+ * open so that it does not need to be re-initialised for the next image.
+ *****************************************************************************/
+static void release_image_device(uintptr_t dev_handle, int io_result)
+{
+#if KEEP_IO_DEV_OPEN
+	unsigned int i;
+	uintptr_t *free_slot = NULL;
+
+	for (i = 0U; i < ARRAY_SIZE(open_image_devs); i++) {
+		if (open_image_devs[i] == dev_handle) {
+			if (io_result != 0) {
+				/* Force re-initialisation on the next access */
+				io_dev_close(dev_handle);
+				open_image_devs[i] = (uintptr_t)NULL;
+			}
+			return;
+		}
+		if ((free_slot == NULL) &&
+		    (open_image_devs[i] == (uintptr_t)NULL))
+			free_slot = &open_image_devs[i];
+	}
+
+	if ((io_result == 0) && (free_slot != NULL)) {
+		*free_slot = dev_handle;
+		return;
+	}
+#endif
+	io_dev_close(dev_handle);
+	/* Ignore improbable/unrecoverable error in 'dev_close' */
+}
+
+/******************************************************************************
+ * Close the device connections kept open by the image loading functions. This
+ * must be called before handing off to the next boot stage.
+ *****************************************************************************/
+void close_image_devices(void)
+{
+#if KEEP_IO_DEV_OPEN
+	unsigned int i;
+
+	for (i = 0U; i < ARRAY_SIZE(open_image_devs); i++) {
+		if (open_image_devs[i] != (uintptr_t)NULL) {
+			io_dev_close(open_image_devs[i]);
+			open_image_devs[i] = (uintptr_t)NULL;
+		}
+	}
+#endif
+}
+
 uintptr_t page_align(uintptr_t value, unsigned dir)
 {
 	/* Round up the limit to the next page boundary */
@@ -134,24 +207,61 @@ size_t get_image_size(unsigned int image_id)
 	io_result = io_close(image_handle);
 	/* Ignore improbable/unrecoverable error in 'close' */
 
-	/* TODO: Consider maintaining open device connection from this
-	 * bootloader stage
-	 */
-	io_result = io_dev_close(dev_handle);
-	/* Ignore improbable/unrecoverable error in 'dev_close' */
+	release_image_device(dev_handle, (image_size == 0U) ? -ENOENT : 0);
 
 	return image_size;
 }
 
+/*******************************************************************************
+ * Internal function to read an image from an open IO entity. If 'auth_stream'
+ * is set, the image is read in blocks of PLAT_AUTH_STREAM_CHUNK_SIZE bytes and
+ * each block is hashed by the authentication module right after it has been
+ * read, while it is still in the data cache.
+ ******************************************************************************/
+static int read_image(uintptr_t image_handle, uintptr_t image_base,
+		      size_t image_size, int auth_stream, size_t *bytes_read)
+{
+#if TRUSTED_BOARD_BOOT && AUTH_STREAM_HASH
+	size_t offset, chunk_size, chunk_read;
+	int io_result;
+
+	if (auth_stream != 0) {
+		for (offset = 0U; offset < image_size; offset += chunk_read) {
+			chunk_size = MIN(image_size - offset,
+					 (size_t)PLAT_AUTH_STREAM_CHUNK_SIZE);
+			io_result = io_read(image_handle, image_base + offset,
+					    chunk_size, &chunk_read);
+			if ((io_result != 0) || (chunk_read == 0U)) {
+				*bytes_read = offset;
+				return io_result;
+			}
+
+			if (auth_mod_stream_update((void *)(image_base + offset),
+						   chunk_read) != 0) {
+				*bytes_read = offset;
+				return -EAUTH;
+			}
+		}
+
+		*bytes_read = offset;
+		return 0;
+	}
+#endif /* TRUSTED_BOARD_BOOT && AUTH_STREAM_HASH */
+
+	return io_read(image_handle, image_base, image_size, bytes_read);
+}
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
  *
- * If the load is successful then the image information is updated.
+ * If the load is successful then the image information is updated. If
+ * 'auth_stream' is set, the image is hashed for authentication as it is read.
  *
  * Returns 0 on success, a negative error code otherwise.
  ******************************************************************************/
-static int load_image(unsigned int image_id, image_info_t *image_data)
+static int load_image(unsigned int image_id, image_info_t *image_data,
+		      int auth_stream)
 {
 	uintptr_t dev_handle;
 	uintptr_t image_handle;
@@ -204,7 +314,8 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
-	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	io_result = read_image(image_handle, image_base, image_size,
+			       auth_stream, &bytes_read);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -217,18 +328,36 @@ exit:
 	io_close(image_handle);
 	/* Ignore improbable/unrecoverable error in 'close' */
 
-	/* TODO: Consider maintaining open device connection from this bootloader stage */
-	io_dev_close(dev_handle);
-	/* Ignore improbable/unrecoverable error in 'dev_close' */
+	release_image_device(dev_handle, io_result);
 
 	return io_result;
 }
 
+#if TRUSTED_BOARD_BOOT
+/*
+ * Authenticate a loaded image, completing the authentication started while
+ * loading it if 'auth_stream' is set.
+ */
+static int auth_loaded_image(unsigned int image_id, image_info_t *image_data,
+			     int auth_stream)
+{
+#if AUTH_STREAM_HASH
+	if (auth_stream != 0) {
+		return auth_mod_stream_finish(image_id);
+	}
+#endif
+	return auth_mod_verify_img(image_id,
+				   (void *)image_data->image_base,
+				   image_data->image_size);
+}
+#endif /* TRUSTED_BOARD_BOOT */
+
 static int load_auth_image_internal(unsigned int image_id,
 				    image_info_t *image_data,
 				    int is_parent_image)
 {
 	int rc;
+	int auth_stream = 0;
 
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
@@ -245,18 +374,33 @@ static int load_auth_image_internal(unsigned int image_id,
 	}
 #endif /* TRUSTED_BOARD_BOOT */
 
+#if TRUSTED_BOARD_BOOT && AUTH_STREAM_HASH
+	/* Authenticate the image while loading it, if possible */
+	if ((dyn_is_auth_disabled() == 0) &&
+	    (auth_mod_stream_start(image_id) == 0)) {
+		auth_stream = 1;
+	}
+#endif
+
+	BOOT_TIMELINE_CAPTURE_IMAGE(image_id, BOOT_TIMELINE_IMG_LOAD_START);
+
 	/* Load the image */
-	rc = load_image(image_id, image_data);
+	rc = load_image(image_id, image_data, auth_stream);
 	if (rc != 0) {
+#if TRUSTED_BOARD_BOOT && AUTH_STREAM_HASH
+		if (auth_stream != 0) {
+			auth_mod_stream_abort();
+		}
+#endif
 		return rc;
 	}
 
+	BOOT_TIMELINE_CAPTURE_IMAGE(image_id, BOOT_TIMELINE_IMG_LOAD_END);
+
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
 		/* Authenticate it */
-		rc = auth_mod_verify_img(image_id,
-					 (void *)image_data->image_base,
-					 image_data->image_size);
+		rc = auth_loaded_image(image_id, image_data, auth_stream);
 		if (rc != 0) {
 			/* Authentication error, zero memory and flush it right away. */
 			zero_normalmem((void *)image_data->image_base,
@@ -265,6 +409,8 @@ static int load_auth_image_internal(unsigned int image_id,
 					   image_data->image_size);
 			return -EAUTH;
 		}
+		BOOT_TIMELINE_CAPTURE_IMAGE(image_id,
+					    BOOT_TIMELINE_IMG_AUTH_END);
 	}
 #endif /* TRUSTED_BOARD_BOOT */
 
@@ -296,6 +442,10 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 
 	do {
 		err = load_auth_image_internal(image_id, image_data, 0);
+		if (err != 0) {
+			/* Re-initialise devices if another source is tried */
+			close_image_devices();
+		}
 	} while (err != 0 && plat_try_next_boot_source());
 
 	return err;
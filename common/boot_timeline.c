@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <boot_timeline.h>
+#include <debug.h>
+#include <platform_def.h>
+#include <pmf.h>
+#include <stdint.h>
+
+/*
+ * The boot timeline records the system counter value at points of interest
+ * of the cold boot path, from BL1 entry to the BL31 hand-off. The time-stamps
+ * are kept in memory reserved by the platform at PLAT_BOOT_TIMELINE_BASE,
+ * which must be mapped and preserved in all the boot stages. Each time-stamp
+ * is written to memory directly, as the stages run with different MMU and
+ * cache settings.
+ */
+#define BOOT_TIMELINE_MAGIC		0x4c544f42U	/* "BOTL" */
+
+typedef struct boot_timeline {
+	uint32_t magic;
+	uint32_t total_ids;
+	unsigned long long ts[BOOT_TIMELINE_TOTAL_IDS];
+} boot_timeline_t;
+
+CASSERT(sizeof(boot_timeline_t) == BOOT_TIMELINE_SIZE,
+	assert_boot_timeline_size_mismatch);
+CASSERT(BOOT_TIMELINE_TOTAL_IDS <= (PMF_TID_MASK + 1),
+	assert_boot_timeline_ids_exceed_pmf_tid);
+
+static boot_timeline_t *const timeline =
+	(boot_timeline_t *)PLAT_BOOT_TIMELINE_BASE;
+
+static const char *const boot_timeline_names[BOOT_TIMELINE_IMG_BASE] = {
+	[BOOT_TIMELINE_BL1_ENTRY]	= "BL1 entry",
+	[BOOT_TIMELINE_BL1_EXIT]	= "BL1 exit",
+	[BOOT_TIMELINE_BL2_ENTRY]	= "BL2 entry",
+	[BOOT_TIMELINE_BL2_EXIT]	= "BL2 exit",
+	[BOOT_TIMELINE_BL31_ENTRY]	= "BL31 entry",
+	[BOOT_TIMELINE_BL31_EXIT]	= "BL31 exit",
+	[BOOT_TIMELINE_DDR_INIT_START]	= "DDR init start",
+	[BOOT_TIMELINE_DDR_INIT_END]	= "DDR init end",
+};
+
+/*******************************************************************************
+ * Clear the timeline. Called by the first boot stage before any capture.
+ ******************************************************************************/
+void boot_timeline_init(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < BOOT_TIMELINE_TOTAL_IDS; i++)
+		timeline->ts[i] = 0ULL;
+
+	timeline->total_ids = BOOT_TIMELINE_TOTAL_IDS;
+	timeline->magic = BOOT_TIMELINE_MAGIC;
+
+	flush_dcache_range((uintptr_t)timeline, sizeof(boot_timeline_t));
+}
+
+void boot_timeline_capture(unsigned int tid)
+{
+	unsigned long long ts = read_cntpct_el0();
+
+	assert(tid < BOOT_TIMELINE_TOTAL_IDS);
+
+	if (timeline->magic != BOOT_TIMELINE_MAGIC)
+		return;
+
+	timeline->ts[tid] = ts;
+	flush_dcache_range((uintptr_t)&timeline->ts[tid],
+			   sizeof(unsigned long long));
+}
+
+void boot_timeline_capture_image(unsigned int image_id, unsigned int event)
+{
+	assert(event < BOOT_TIMELINE_IMG_EVENTS);
+
+	if (image_id < BOOT_TIMELINE_MAX_IMAGES)
+		boot_timeline_capture(BOOT_TIMELINE_IMG_ID(image_id, event));
+}
+
+/*******************************************************************************
+ * Return the time-stamp of event `tid`, or 0 if it has not been captured.
+ ******************************************************************************/
+unsigned long long boot_timeline_get(unsigned int tid)
+{
+	uintptr_t addr;
+
+	if (tid >= BOOT_TIMELINE_TOTAL_IDS)
+		return 0ULL;
+
+	inv_dcache_range((uintptr_t)timeline, sizeof(uint32_t));
+	addr = (uintptr_t)&timeline->ts[tid];
+	inv_dcache_range(addr, sizeof(unsigned long long));
+
+	if (timeline->magic != BOOT_TIMELINE_MAGIC)
+		return 0ULL;
+
+	return timeline->ts[tid];
+}
+
+static unsigned long long ticks_to_us(unsigned long long ticks,
+				      unsigned long long freq)
+{
+	return ((ticks / freq) * 1000000ULL) +
+	       (((ticks % freq) * 1000000ULL) / freq);
+}
+
+static unsigned long long image_delta_us(unsigned int image_id,
+					 unsigned int start, unsigned int end,
+					 unsigned long long freq)
+{
+	unsigned long long ts_start, ts_end;
+
+	ts_start = boot_timeline_get(BOOT_TIMELINE_IMG_ID(image_id, start));
+	ts_end = boot_timeline_get(BOOT_TIMELINE_IMG_ID(image_id, end));
+
+	if ((ts_start == 0ULL) || (ts_end < ts_start))
+		return 0ULL;
+
+	return ticks_to_us(ts_end - ts_start, freq);
+}
+
+/*******************************************************************************
+ * Print the captured events: the boot stage events with their time since
+ * the counter started, then the time spent on each image.
+ ******************************************************************************/
+void boot_timeline_print(void)
+{
+	unsigned long long freq = read_cntfrq_el0();
+	unsigned long long ts, prev = 0ULL;
+	unsigned int i;
+
+	if (freq == 0ULL) {
+		WARN("Boot timeline: counter frequency not set\n");
+		return;
+	}
+
+	NOTICE("Boot timeline (us since counter start):\n");
+
+	for (i = 0U; i < BOOT_TIMELINE_IMG_BASE; i++) {
+		ts = boot_timeline_get(i);
+		if (ts == 0ULL)
+			continue;
+
+		NOTICE("  %s: %llu (+%llu)\n", boot_timeline_names[i],
+		       ticks_to_us(ts, freq),
+		       (prev == 0ULL) ? 0ULL : ticks_to_us(ts - prev, freq));
+		prev = ts;
+	}
+
+	for (i = 0U; i < BOOT_TIMELINE_MAX_IMAGES; i++) {
+		ts = boot_timeline_get(BOOT_TIMELINE_IMG_ID(i,
+					BOOT_TIMELINE_IMG_LOAD_START));
+		if (ts == 0ULL)
+			continue;
+
+		NOTICE("  image %u: %llu (io %llu, auth %llu, post-load %llu)\n",
+		       i, ticks_to_us(ts, freq),
+		       image_delta_us(i, BOOT_TIMELINE_IMG_LOAD_START,
+				      BOOT_TIMELINE_IMG_LOAD_END, freq),
+		       image_delta_us(i, BOOT_TIMELINE_IMG_LOAD_END,
+				      BOOT_TIMELINE_IMG_AUTH_END, freq),
+		       image_delta_us(i, BOOT_TIMELINE_IMG_POST_START,
+				      BOOT_TIMELINE_IMG_POST_END, freq));
+	}
+}
+
+#if defined(IMAGE_BL31) && ENABLE_PMF
+/*
+ * Export the timeline through the PMF SMC interface. The time-stamps are
+ * global, so `mpidr` only needs to identify a valid CPU.
+ */
+static unsigned long long boot_timeline_get_ts(unsigned int tid,
+					       u_register_t mpidr,
+					       unsigned int flags)
+{
+	return boot_timeline_get(tid & PMF_TID_MASK);
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(boot_timeline_svc, PMF_ARM_TIF_IMPL_ID,
+			     PMF_BOOT_TIMELINE_SVC_ID, BOOT_TIMELINE_TOTAL_IDS,
+			     NULL, boot_timeline_get_ts)
+#endif
@@ -10,59 +10,115 @@
 #include <debug.h>
 #include <image_decompress.h>
 #include <stdint.h>
+#if BL2_PARALLEL_WORK
+#include <bl2_work.h>
+#endif
 
-static uintptr_t decompressor_buf_base;
-static uint32_t decompressor_buf_size;
+/*
+ * With BL2_PARALLEL_WORK, the decompression of an image is deferred to BL2
+ * work so that the next image is loaded in the meantime. Each temporary
+ * buffer then holds the compressed data of one image until the decompression
+ * of that image is done, and images are given the buffers in turn.
+ */
+#if BL2_PARALLEL_WORK
+#define DECOMPRESSOR_MAX_BUFS	2
+#else
+#define DECOMPRESSOR_MAX_BUFS	1
+#endif
+
+struct decompressor_buf {
+	uintptr_t base;
+	uint32_t size;
+	/* Image being loaded to the buffer, and its saved image_info */
+	struct image_info *info;
+	struct image_info saved_image_info;
+	uintptr_t compressed_image_base;
+	uint32_t compressed_image_size;
+#if BL2_PARALLEL_WORK
+	bl2_work_t work;
+#endif
+};
+
+static struct decompressor_buf decompressor_bufs[DECOMPRESSOR_MAX_BUFS];
+static unsigned int decompressor_buf_count;
+static unsigned int decompressor_buf_next;
 static decompressor_t *decompressor;
-static struct image_info saved_image_info;
 
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
-	decompressor_buf_base = buf_base;
-	decompressor_buf_size = buf_size;
+	decompressor_bufs[0].base = buf_base;
+	decompressor_bufs[0].size = buf_size;
+	decompressor_buf_count = 1U;
+	decompressor_buf_next = 0U;
 	decompressor = _decompressor;
 }
 
+#if BL2_PARALLEL_WORK
+/*
+ * Register an additional temporary buffer, so that an image can be loaded
+ * while the previous one is being decompressed.
+ */
+void image_decompress_add_buf(uintptr_t buf_base, uint32_t buf_size)
+{
+	assert(decompressor_buf_count > 0U);
+	assert(decompressor_buf_count < DECOMPRESSOR_MAX_BUFS);
+
+	decompressor_bufs[decompressor_buf_count].base = buf_base;
+	decompressor_bufs[decompressor_buf_count].size = buf_size;
+	decompressor_buf_count++;
+}
+#endif
+
 void image_decompress_prepare(struct image_info *info)
 {
+	struct decompressor_buf *buf;
+
+	assert(decompressor_buf_count > 0U);
+
+	buf = &decompressor_bufs[decompressor_buf_next];
+	decompressor_buf_next = (decompressor_buf_next + 1U) %
+				decompressor_buf_count;
+
+#if BL2_PARALLEL_WORK
+	/*
+	 * The buffer may still hold the compressed data of an earlier image.
+	 * Errors of that decompression are reported by bl2_work_barrier().
+	 */
+	(void)bl2_work_wait(&buf->work);
+#endif
+
 	/*
 	 * If the image is compressed, it should be loaded into the temporary
 	 * buffer instead of its final destination.  We save image_info, then
 	 * override ->image_base and ->image_max_size so that load_image() will
 	 * transfer the compressed data to the temporary buffer.
 	 */
-	saved_image_info = *info;
-	info->image_base = decompressor_buf_base;
-	info->image_max_size = decompressor_buf_size;
+	buf->info = info;
+	buf->saved_image_info = *info;
+	info->image_base = buf->base;
+	info->image_max_size = buf->size;
 }
 
-int image_decompress(struct image_info *info)
+static int decompress_buf(void *arg)
 {
+	struct decompressor_buf *buf = arg;
+	struct image_info *info = buf->info;
 	uintptr_t compressed_image_base, image_base, work_base;
-	uint32_t compressed_image_size, work_size;
+	uint32_t work_size;
 	int ret;
 
-	/*
-	 * The size of compressed data has been filled by load_image().
-	 * Read it out before restoring image_info.
-	 */
-	compressed_image_size = info->image_size;
-	compressed_image_base = info->image_base;
-	*info = saved_image_info;
-
-	assert(compressed_image_size <= decompressor_buf_size);
-
 	image_base = info->image_base;
+	compressed_image_base = buf->compressed_image_base;
 
 	/*
 	 * Use the rest of the temporary buffer as workspace of the
 	 * decompressor since the decompressor may need additional memory.
 	 */
-	work_base = compressed_image_base + compressed_image_size;
-	work_size = decompressor_buf_size - compressed_image_size;
+	work_base = compressed_image_base + buf->compressed_image_size;
+	work_size = buf->size - buf->compressed_image_size;
 
-	ret = decompressor(&compressed_image_base, compressed_image_size,
+	ret = decompressor(&compressed_image_base, buf->compressed_image_size,
 			   &image_base, info->image_max_size,
 			   work_base, work_size);
 	if (ret) {
@@ -77,3 +133,60 @@ int image_decompress(struct image_info *info)
 
 	return 0;
 }
+
+static struct decompressor_buf *find_buf(struct image_info *info)
+{
+	unsigned int i;
+
+	for (i = 0U; i < decompressor_buf_count; i++) {
+		if (decompressor_bufs[i].info == info)
+			return &decompressor_bufs[i];
+	}
+
+	return NULL;
+}
+
+int image_decompress(struct image_info *info)
+{
+	struct decompressor_buf *buf = find_buf(info);
+
+	assert(buf != NULL);
+
+	/*
+	 * The size of compressed data has been filled by load_image().
+	 * Read it out before restoring image_info.
+	 */
+	buf->compressed_image_size = info->image_size;
+	buf->compressed_image_base = info->image_base;
+	*info = buf->saved_image_info;
+
+	assert(buf->compressed_image_size <= buf->size);
+
+#if BL2_PARALLEL_WORK
+	/*
+	 * The decompressed image is only used once BL2 has waited for all its
+	 * work to be done, or by the platform after image_decompress_wait().
+	 * BL2 checks for errors after each image it loads.
+	 */
+	bl2_work_submit(&buf->work, decompress_buf, buf, NULL);
+	return 0;
+#else
+	return decompress_buf(buf);
+#endif
+}
+
+#if BL2_PARALLEL_WORK
+/*
+ * Wait until the decompression of the image deferred by image_decompress() is
+ * done and return its result. This is needed when the platform uses the image
+ * before BL2 hands off, e.g. to start a co-processor.
+ */
+int image_decompress_wait(struct image_info *info)
+{
+	struct decompressor_buf *buf = find_buf(info);
+
+	assert(buf != NULL);
+
+	return bl2_work_wait(&buf->work);
+}
+#endif
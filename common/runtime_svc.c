@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <platform.h>
 #include <runtime_svc.h>
 #include <string.h>
 
@@ -24,6 +25,10 @@ uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 #define RT_SVC_DECS_NUM		((RT_SVC_DESCS_END - RT_SVC_DESCS_START)\
 					/ sizeof(rt_svc_desc_t))
 
+#define RT_SVC_FID_TABLES_NUM	((RT_SVC_FID_TABLES_END -		\
+				  RT_SVC_FID_TABLES_START)		\
+					/ sizeof(rt_svc_fid_table_t))
+
 /*******************************************************************************
  * Function to invoke the registered `handle` corresponding to the smc_fid in
  * AArch32 mode.
@@ -74,6 +79,11 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
 	if ((desc->call_type != SMC_TYPE_FAST) &&
 	    (desc->call_type != SMC_TYPE_YIELD))
 		return -EINVAL;
+
+	/* Yielding calls may switch context, which leaf calls must not do */
+	if (((desc->flags & RT_SVC_FLAG_LEAF) != 0U) &&
+	    (desc->call_type != SMC_TYPE_FAST))
+		return -EINVAL;
 #elif SMCCC_MAJOR_VERSION == 2
 	if (desc->is_vendor > 1U)
 		return -EINVAL;
@@ -83,9 +93,103 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
 	if ((desc->init == NULL) && (desc->handle == NULL))
 		return -EINVAL;
 
+	if ((desc->flags & ~RT_SVC_FLAG_LEAF) != 0U)
+		return -EINVAL;
+
 	return 0;
 }
 
+/*******************************************************************************
+ * Check that a table of function IDs is sorted and that all its entries have a
+ * handler
+ ******************************************************************************/
+static int32_t validate_rt_svc_fid_table(const rt_svc_fid_table_t *table)
+{
+	unsigned int i;
+
+	if ((table->fids == NULL) || (table->num_fids == 0U))
+		return -EINVAL;
+
+	for (i = 0U; i < table->num_fids; i++) {
+		if (table->fids[i].handle == NULL)
+			return -EINVAL;
+
+		if ((i > 0U) && (table->fids[i].fid <= table->fids[i - 1U].fid))
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Return the handler of `smc_fid` in `table`, or NULL if the table has no entry
+ * for this function ID.
+ ******************************************************************************/
+rt_svc_handle_t rt_svc_fid_lookup(const rt_svc_fid_table_t *table,
+				  uint32_t smc_fid)
+{
+	const rt_svc_fid_t *fids = table->fids;
+	unsigned int last = table->num_fids - 1U;
+	unsigned int lo, hi, idx;
+
+	if ((smc_fid < fids[0].fid) || (smc_fid > fids[last].fid))
+		return NULL;
+
+	if ((fids[last].fid - fids[0].fid) == last) {
+		/* Dense table: the entries follow the function IDs */
+		idx = smc_fid - fids[0].fid;
+	} else {
+		lo = 0U;
+		hi = last;
+		for (;;) {
+			idx = lo + ((hi - lo) / 2U);
+			if (fids[idx].fid == smc_fid)
+				break;
+			if (lo == hi)
+				return NULL;
+			if (fids[idx].fid < smc_fid)
+				lo = idx + 1U;
+			else
+				hi = idx;
+		}
+	}
+
+	assert(fids[idx].fid == smc_fid);
+
+#if ENABLE_RT_SVC_FID_STATS
+	table->counts[(plat_my_core_pos() * table->num_fids) + idx]++;
+#endif
+
+	return fids[idx].handle;
+}
+
+#if ENABLE_RT_SVC_FID_STATS
+/*******************************************************************************
+ * Return the number of calls to `smc_fid` made through the tables of function
+ * IDs on all CPUs.
+ ******************************************************************************/
+unsigned long long rt_svc_fid_call_count(uint32_t smc_fid)
+{
+	const rt_svc_fid_table_t *tables =
+		(const rt_svc_fid_table_t *)RT_SVC_FID_TABLES_START;
+	unsigned long long count = 0ULL;
+	unsigned int i, j, cpu;
+
+	for (i = 0U; i < RT_SVC_FID_TABLES_NUM; i++) {
+		for (j = 0U; j < tables[i].num_fids; j++) {
+			if (tables[i].fids[j].fid != smc_fid)
+				continue;
+
+			for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++)
+				count += tables[i].counts[
+					(cpu * tables[i].num_fids) + j];
+		}
+	}
+
+	return count;
+}
+#endif /* ENABLE_RT_SVC_FID_STATS */
+
 /*******************************************************************************
  * This function calls the initialisation routine in the descriptor exported by
  * a runtime service. Once a descriptor has been validated, its start & end
@@ -107,6 +211,21 @@ void runtime_svc_init(void)
 	if (RT_SVC_DECS_NUM == 0U)
 		return;
 
+	/*
+	 * The tables of function IDs are used as is by the services, so an
+	 * invalid table is an error condition as well.
+	 */
+	for (index = 0; index < RT_SVC_FID_TABLES_NUM; index++) {
+		const rt_svc_fid_table_t *table =
+			&((const rt_svc_fid_table_t *)
+			  RT_SVC_FID_TABLES_START)[index];
+
+		if (validate_rt_svc_fid_table(table) != 0) {
+			ERROR("Invalid function ID table %s\n", table->name);
+			panic();
+		}
+	}
+
 	/* Initialise internal variables to invalid state */
 	memset(rt_svc_descs_indices, -1, sizeof(rt_svc_descs_indices));
 
@@ -7,6 +7,9 @@
 #include <assert.h>
 #include <debug.h>
 #include <platform.h>
+#if defined(IMAGE_BL2) && BL2_PARALLEL_WORK
+#include <bl2_work.h>
+#endif
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
 static unsigned int max_log_level = LOG_LEVEL;
@@ -36,6 +39,10 @@ void tf_log(const char *fmt, ...)
 
 	prefix_str = plat_log_get_prefix(log_level);
 
+#if defined(IMAGE_BL2) && BL2_PARALLEL_WORK
+	bl2_work_console_lock();
+#endif
+
 	while (*prefix_str != '\0') {
 		(void)putchar(*prefix_str);
 		prefix_str++;
@@ -44,6 +51,10 @@ void tf_log(const char *fmt, ...)
 	va_start(args, fmt);
 	(void)vprintf(fmt + 1, args);
 	va_end(args);
+
+#if defined(IMAGE_BL2) && BL2_PARALLEL_WORK
+	bl2_work_console_unlock();
+#endif
 }
 
 /*
@@ -279,6 +279,14 @@ void gicd_set_icenabler(uintptr_t base, unsigned int id)
 	gicd_write_icenabler(base, id, (1U << bit_num));
 }
 
+unsigned int gicd_get_ispendr(uintptr_t base, unsigned int id)
+{
+	unsigned int bit_num = id & ((1U << ISPENDR_SHIFT) - 1U);
+	unsigned int reg_val = gicd_read_ispendr(base, id);
+
+	return (reg_val >> bit_num) & 0x1U;
+}
+
 void gicd_set_ispendr(uintptr_t base, unsigned int id)
 {
 	unsigned int bit_num = id & ((1U << ISPENDR_SHIFT) - 1U);
@@ -77,6 +77,7 @@ void gicd_set_igroupr(uintptr_t base, unsigned int id);
 void gicd_clr_igroupr(uintptr_t base, unsigned int id);
 void gicd_set_isenabler(uintptr_t base, unsigned int id);
 void gicd_set_icenabler(uintptr_t base, unsigned int id);
+unsigned int gicd_get_ispendr(uintptr_t base, unsigned int id);
 void gicd_set_ispendr(uintptr_t base, unsigned int id);
 void gicd_set_icpendr(uintptr_t base, unsigned int id);
 unsigned int gicd_get_isactiver(uintptr_t base, unsigned int id);
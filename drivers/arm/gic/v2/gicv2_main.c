@@ -328,6 +328,19 @@ unsigned int gicv2_get_interrupt_active(unsigned int id)
 	return gicd_get_isactiver(driver_data->gicd_base, id);
 }
 
+/*******************************************************************************
+ * This function returns the pending status of the interrupt (either because the
+ * state is pending, or active and pending).
+ ******************************************************************************/
+unsigned int gicv2_get_interrupt_pending(unsigned int id)
+{
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(id <= MAX_SPI_ID);
+
+	return gicd_get_ispendr(driver_data->gicd_base, id);
+}
+
 /*******************************************************************************
  * This function enables the interrupt identified by id.
  ******************************************************************************/
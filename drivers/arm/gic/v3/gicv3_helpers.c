@@ -200,6 +200,18 @@ unsigned int gicr_get_isactiver0(uintptr_t base, unsigned int id)
 	return (reg_val >> bit_num) & 0x1U;
 }
 
+/*
+ * Accessor to get the bit corresponding to interrupt ID in GIC Re-distributor
+ * ISPENDR0.
+ */
+unsigned int gicr_get_ispendr0(uintptr_t base, unsigned int id)
+{
+	unsigned int bit_num = id & ((1U << ISPENDR_SHIFT) - 1U);
+	unsigned int reg_val = gicr_read_ispendr0(base);
+
+	return (reg_val >> bit_num) & 0x1U;
+}
+
 /*
  * Accessor to clear the bit corresponding to interrupt ID in GIC Re-distributor
  * ICPENDRR0.
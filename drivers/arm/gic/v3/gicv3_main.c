@@ -780,6 +780,33 @@ unsigned int gicv3_get_interrupt_active(unsigned int id, unsigned int proc_num)
 	return value;
 }
 
+/*******************************************************************************
+ * This function checks if the interrupt identified by id is pending (whether
+ * the state is either pending, or active and pending). The proc_num is used if
+ * the interrupt is SGI or PPI and programs the corresponding Redistributor
+ * interface.
+ ******************************************************************************/
+unsigned int gicv3_get_interrupt_pending(unsigned int id, unsigned int proc_num)
+{
+	unsigned int value;
+
+	assert(gicv3_driver_data != NULL);
+	assert(gicv3_driver_data->gicd_base != 0U);
+	assert(proc_num < gicv3_driver_data->rdistif_num);
+	assert(gicv3_driver_data->rdistif_base_addrs != NULL);
+	assert(id <= MAX_SPI_ID);
+
+	if (id < MIN_SPI_ID) {
+		/* For SGIs and PPIs */
+		value = gicr_get_ispendr0(
+				gicv3_driver_data->rdistif_base_addrs[proc_num], id);
+	} else {
+		value = gicd_get_ispendr(gicv3_driver_data->gicd_base, id);
+	}
+
+	return value;
+}
+
 /*******************************************************************************
  * This function enables the interrupt identified by id. The proc_num
  * is used if the interrupt is SGI or PPI, and programs the corresponding
@@ -413,3 +413,102 @@ int auth_mod_verify_img(unsigned int img_id,
 
 	return 0;
 }
+
+#if AUTH_STREAM_HASH
+/*
+ * Start the authentication of an image while it is being loaded
+ *
+ * This is only possible for raw images authenticated by hash only, once their
+ * parent has been authenticated. The image data is then fed to
+ * auth_mod_stream_update() as it is loaded and the authentication completed
+ * by auth_mod_stream_finish(). Otherwise the image must be authenticated after
+ * it has been loaded, by auth_mod_verify_img().
+ *
+ * Return: 0 = streaming authentication started, Otherwise = not possible
+ */
+int auth_mod_stream_start(unsigned int img_id)
+{
+	const auth_img_desc_t *img_desc = NULL;
+	const auth_method_desc_t *auth_method;
+	const auth_method_param_hash_t *param = NULL;
+	void *hash_der_ptr;
+	unsigned int hash_der_len;
+	int rc, i;
+
+	/* Get the image descriptor from the chain of trust */
+	img_desc = &cot_desc_ptr[img_id];
+
+	if ((img_desc->img_type != IMG_RAW) || (img_desc->parent == NULL)) {
+		return 1;
+	}
+
+	/* The only authentication method allowed is a single hash */
+	for (i = 0 ; i < AUTH_METHOD_NUM ; i++) {
+		auth_method = &img_desc->img_auth_methods[i];
+		if (auth_method->type == AUTH_METHOD_NONE) {
+			continue;
+		}
+		if ((auth_method->type != AUTH_METHOD_HASH) ||
+		    (param != NULL)) {
+			return 1;
+		}
+		param = &auth_method->param.hash;
+	}
+	if (param == NULL) {
+		return 1;
+	}
+
+	/* No parameters can be extracted from raw images for children */
+	for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+		if (img_desc->authenticated_data[i].type_desc != NULL) {
+			return 1;
+		}
+	}
+
+	/* Get the hash from the parent image. This hash will be DER encoded
+	 * and contain the hash algorithm */
+	rc = auth_get_param(param->hash, img_desc->parent,
+			&hash_der_ptr, &hash_der_len);
+	return_if_error(rc);
+
+	return crypto_mod_verify_hash_start(hash_der_ptr, hash_der_len);
+}
+
+/*
+ * Hash a block of the image being loaded
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+int auth_mod_stream_update(void *data_ptr, unsigned int data_len)
+{
+	return crypto_mod_verify_hash_update(data_ptr, data_len);
+}
+
+/*
+ * Complete the authentication of an image started by auth_mod_stream_start()
+ * once all its data has been loaded and hashed.
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+int auth_mod_stream_finish(unsigned int img_id)
+{
+	int rc;
+
+	rc = crypto_mod_verify_hash_finish();
+	return_if_error(rc);
+
+	/* Mark image as authenticated */
+	auth_img_flags[cot_desc_ptr[img_id].img_id] |= IMG_FLAG_AUTHENTICATED;
+
+	return 0;
+}
+
+/*
+ * Abandon the authentication of an image started by auth_mod_stream_start(),
+ * e.g. because it could not be loaded completely.
+ */
+void auth_mod_stream_abort(void)
+{
+	(void)crypto_mod_verify_hash_finish();
+}
+#endif /* AUTH_STREAM_HASH */
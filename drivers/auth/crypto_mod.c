@@ -102,3 +102,54 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 	return crypto_lib_desc.verify_hash(data_ptr, data_len,
 					   digest_info_ptr, digest_info_len);
 }
+
+#if AUTH_STREAM_HASH
+/*
+ * Start an incremental hash verification
+ *
+ * Parameters:
+ *
+ *   digest_info_ptr, digest_info_len: hash to be compared
+ *
+ * Return CRYPTO_ERR_UNKNOWN if the library does not support it.
+ */
+int crypto_mod_verify_hash_start(void *digest_info_ptr,
+				 unsigned int digest_info_len)
+{
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0);
+
+	if ((crypto_lib_desc.verify_hash_start == NULL) ||
+	    (crypto_lib_desc.verify_hash_update == NULL) ||
+	    (crypto_lib_desc.verify_hash_finish == NULL)) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_lib_desc.verify_hash_start(digest_info_ptr,
+						 digest_info_len);
+}
+
+/*
+ * Add data to the incremental hash verification in progress
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: data to be hashed
+ */
+int crypto_mod_verify_hash_update(void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+
+	return crypto_lib_desc.verify_hash_update(data_ptr, data_len);
+}
+
+/*
+ * Compare the result of the incremental hash verification in progress and
+ * release it
+ */
+int crypto_mod_verify_hash_finish(void)
+{
+	return crypto_lib_desc.verify_hash_finish();
+}
+#endif /* AUTH_STREAM_HASH */
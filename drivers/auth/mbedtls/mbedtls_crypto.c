@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -135,19 +135,18 @@ end2:
 }
 
 /*
- * Match a hash
+ * Get the hash algorithm and the hash value from a digest info
  *
  * Digest info is passed in DER format following the ASN.1 structure detailed
  * above.
  */
-static int verify_hash(void *data_ptr, unsigned int data_len,
-		       void *digest_info_ptr, unsigned int digest_info_len)
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   const mbedtls_md_info_t **md_info,
+			   unsigned char **hash)
 {
 	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
-	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
-	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	unsigned char *p, *end;
 	size_t len;
 	int rc;
 
@@ -171,8 +170,8 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 		return CRYPTO_ERR_HASH;
 	}
 
-	md_info = mbedtls_md_info_from_type(md_alg);
-	if (md_info == NULL) {
+	*md_info = mbedtls_md_info_from_type(md_alg);
+	if (*md_info == NULL) {
 		return CRYPTO_ERR_HASH;
 	}
 
@@ -183,10 +182,32 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 
 	/* Length of hash must match the algorithm's size */
-	if (len != mbedtls_md_get_size(md_info)) {
+	if (len != mbedtls_md_get_size(*md_info)) {
 		return CRYPTO_ERR_HASH;
 	}
-	hash = p;
+	*hash = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Match a hash
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash(void *data_ptr, unsigned int data_len,
+		       void *digest_info_ptr, unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *p, *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
 
 	/* Calculate the hash of the data */
 	p = (unsigned char *)data_ptr;
@@ -204,7 +225,105 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	return CRYPTO_SUCCESS;
 }
 
+#if AUTH_STREAM_HASH
+/* Incremental hash calculation in progress and the hash to compare it with */
+static mbedtls_md_context_t stream_ctx;
+static unsigned char stream_hash[MBEDTLS_MD_MAX_SIZE];
+static int stream_active;
+
+/*
+ * Start an incremental hash verification
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash_start(void *digest_info_ptr,
+			     unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	int rc;
+
+	if (stream_active != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+
+	mbedtls_md_init(&stream_ctx);
+	rc = mbedtls_md_setup(&stream_ctx, md_info, 0);
+	if (rc == 0) {
+		rc = mbedtls_md_starts(&stream_ctx);
+	}
+	if (rc != 0) {
+		mbedtls_md_free(&stream_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	memcpy(stream_hash, hash, mbedtls_md_get_size(md_info));
+	stream_active = 1;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Hash a block of data as part of the incremental hash verification
+ */
+static int verify_hash_update(void *data_ptr, unsigned int data_len)
+{
+	if (stream_active == 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if (mbedtls_md_update(&stream_ctx, (unsigned char *)data_ptr,
+			      data_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Compare the hash of all the data with the expected one
+ */
+static int verify_hash_finish(void)
+{
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	size_t len;
+	int rc;
+
+	if (stream_active == 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	len = mbedtls_md_get_size(stream_ctx.md_info);
+	rc = mbedtls_md_finish(&stream_ctx, data_hash);
+	mbedtls_md_free(&stream_ctx);
+	stream_active = 0;
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Compare values */
+	rc = memcmp(data_hash, stream_hash, len);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+#endif /* AUTH_STREAM_HASH */
+
 /*
  * Register crypto library descriptor
  */
+#if AUTH_STREAM_HASH
+REGISTER_CRYPTO_LIB_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+			   verify_hash_start, verify_hash_update,
+			   verify_hash_finish);
+#else
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash);
+#endif
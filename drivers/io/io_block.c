@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -120,6 +120,22 @@ static int free_dev_info(io_dev_info_t *dev_info)
 	return result;
 }
 
+/*
+ * Return 1 if the next transfer of a read or write can bypass the bounce
+ * buffer, i.e. the device supports it, the current position is aligned to a
+ * block boundary, at least one whole block is left to transfer and the
+ * caller's buffer is block-aligned.
+ */
+static int is_direct_xfer(const block_dev_state_t *cur, size_t skip,
+			  size_t left, uintptr_t addr)
+{
+	size_t block_size = cur->dev_spec->block_size;
+
+	return ((cur->dev_spec->flags & IO_BLOCK_FLAG_DIRECT_XFER) != 0U) &&
+	       (skip == 0U) && (left >= block_size) &&
+	       ((addr & (block_size - 1U)) == 0U);
+}
+
 static int block_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		      io_entity_t *entity)
 {
@@ -236,6 +252,11 @@ static int block_seek(io_entity_t *entity, int mode, ssize_t offset)
  *
  * Additionally, the IO driver has an underlying buffer that is at least
  * one block-size and may be big enough to allow.
+ *
+ * If the device supports direct transfers (IO_BLOCK_FLAG_DIRECT_XFER), the
+ * whole blocks of a request starting on a block boundary are read straight
+ * into a block-aligned user buffer. Only the unaligned head and tail of the
+ * request then go through the underlying buffer.
  */
 static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		      size_t *length_read)
@@ -292,6 +313,20 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		 */
 		lba = (cur->file_pos + cur->base) / block_size;
 
+		if (is_direct_xfer(cur, skip, left, buffer + count) != 0) {
+			/* Read all the whole blocks left into the user buffer */
+			request = ops->read(lba, buffer + count,
+					    left & ~(block_size - 1));
+			if (request == 0)
+				return -EIO;
+
+			assert(request <= left);
+			nbytes = request;
+			cur->file_pos += nbytes;
+			count += nbytes;
+			continue;
+		}
+
 		if (skip + left > buf->length) {
 			/*
 			 * The underlying read buffer is too small to
@@ -346,7 +381,8 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
  * This function allows the caller to write any number of bytes
  * from any position. It hides from the caller that the low level
  * driver only can write aligned blocks of data.
- * See comments for block_read for more details.
+ * Direct transfers from the user buffer are used in the same cases as in
+ * block_read. See comments for block_read for more details.
  */
 static int block_write(io_entity_t *entity, const uintptr_t buffer,
 		       size_t length, size_t *length_written)
@@ -404,6 +440,20 @@ static int block_write(io_entity_t *entity, const uintptr_t buffer,
 		 */
 		lba = (cur->file_pos + cur->base) / block_size;
 
+		if (is_direct_xfer(cur, skip, left, buffer + count) != 0) {
+			/* Write all the whole blocks left from the user buffer */
+			request = ops->write(lba, buffer + count,
+					     left & ~(block_size - 1));
+			if (request == 0)
+				return -EIO;
+
+			assert(request <= left);
+			nbytes = request;
+			cur->file_pos += nbytes;
+			count += nbytes;
+			continue;
+		}
+
 		if (skip + left > buf->length) {
 			/*
 			 * The underlying read buffer is too small to
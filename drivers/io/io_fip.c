@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <bl_common.h>
+#include <cassert.h>
 #include <debug.h>
 #include <errno.h>
 #include <firmware_image_package.h>
@@ -23,6 +24,36 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+/*
+ * Maximum number of ToC entries cached per FIP device. FIPs with more entries
+ * than this are still supported, but lookups of UUIDs that do not fit in the
+ * cache fall back to scanning the ToC through the backend.
+ */
+#ifndef PLAT_FIP_MAX_TOC_ENTRIES
+#define PLAT_FIP_MAX_TOC_ENTRIES	32
+#endif
+
+CASSERT(PLAT_FIP_MAX_TOC_ENTRIES <= 255, assert_plat_fip_max_toc_entries);
+
+/*
+ * Maximum number of files that can be open at the same time across all FIP
+ * devices.
+ */
+#ifndef PLAT_FIP_MAX_OPEN_FILES
+#define PLAT_FIP_MAX_OPEN_FILES		1
+#endif
+
+/*
+ * When set, each FIP device keeps its backend entity open from fip_dev_init()
+ * until fip_dev_close() instead of opening it for every access. This must only
+ * be enabled if no other user needs to open a file on the backend device while
+ * the FIP device is initialised, as backends like io_memmap only support one
+ * open file at a time.
+ */
+#ifndef PLAT_FIP_PERSISTENT_BACKEND
+#define PLAT_FIP_PERSISTENT_BACKEND	0
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -36,27 +67,34 @@ typedef struct {
 	fip_toc_entry_t entry;
 } file_state_t;
 
-/*
- * Maintain dev_spec per FIP Device
- * TODO - Add backend handles and file state
- * per FIP device here once backends like io_memmap
- * can support multiple open files
- */
+/* Maintain dev_spec, backend references and cached ToC per FIP Device */
 typedef struct {
 	uintptr_t dev_spec;
+	uintptr_t backend_dev_handle;
+	uintptr_t backend_image_spec;
+#if PLAT_FIP_PERSISTENT_BACKEND
+	/* Backend entity kept open while the device is initialised */
+	uintptr_t backend_handle;
+#endif
+	/* ToC entries read by fip_dev_init(), sorted by UUID */
+	fip_toc_entry_t toc_cache[PLAT_FIP_MAX_TOC_ENTRIES];
+	/* Position of each cached entry in the FIP ToC */
+	uint8_t toc_index[PLAT_FIP_MAX_TOC_ENTRIES];
+	unsigned int toc_cache_count;
+	/* Set if the ToC did not fit in the cache */
+	unsigned int toc_cache_partial;
+	/* Set once the device has been initialised successfully */
+	unsigned int init_done;
+	unsigned int init_image_id;
 } fip_dev_state_t;
 
 static const uuid_t uuid_null = { {0} };
+
 /*
- * Only one file can be open across all FIP device
- * as backends like io_memmap don't support
- * multiple open files. The file state and
- * backend handle should be maintained per FIP device
- * if the same support is available in the backend
+ * Pool of open file states shared by all FIP devices. The header lives at
+ * offset zero of the FIP, so a zero 'entry.offset_address' marks a free slot.
  */
-static file_state_t current_file = {0};
-static uintptr_t backend_dev_handle;
-static uintptr_t backend_image_spec;
+static file_state_t file_pool[PLAT_FIP_MAX_OPEN_FILES];
 
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
@@ -64,6 +102,9 @@ static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 /* Track number of allocated fip devices */
 static unsigned int fip_dev_count;
 
+/* Number of backend ToC entry reads avoided thanks to the ToC cache */
+static unsigned int fip_toc_reads_saved;
+
 /* Firmware Image Package driver functions */
 static int fip_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
@@ -82,6 +123,90 @@ static inline int compare_uuids(const uuid_t *uuid1, const uuid_t *uuid2)
 	return memcmp(uuid1, uuid2, sizeof(uuid_t));
 }
 
+/*
+ * Read the whole Table of Contents from the backend in a single access and
+ * store it in the device state, sorted by UUID. The backend handle must be
+ * positioned just after the FIP header.
+ */
+static int fip_toc_cache_fill(fip_dev_state_t *state, uintptr_t backend_handle)
+{
+	int result;
+	size_t bytes_read;
+	unsigned int i, j, count;
+	fip_toc_entry_t *toc = state->toc_cache;
+	fip_toc_entry_t tmp;
+
+	state->toc_cache_count = 0U;
+	state->toc_cache_partial = 0U;
+
+	result = io_read(backend_handle, (uintptr_t)toc,
+			 sizeof(state->toc_cache), &bytes_read);
+	if (result != 0) {
+		WARN("Failed to read FIP ToC (%i)\n", result);
+		return result;
+	}
+
+	count = (unsigned int)(bytes_read / sizeof(fip_toc_entry_t));
+
+	/* Stop at the ToC end marker */
+	for (i = 0U; i < count; i++) {
+		if (compare_uuids(&toc[i].uuid, &uuid_null) == 0)
+			break;
+	}
+
+	if (i == count) {
+		/* No end marker found, the cache only holds part of the ToC */
+		WARN("FIP ToC larger than %u entries, cache is partial\n",
+		     count);
+		state->toc_cache_partial = 1U;
+	}
+	count = i;
+
+	/* Insertion sort by UUID, the ToC only has a few entries */
+	for (i = 0U; i < count; i++) {
+		tmp = toc[i];
+		for (j = i; j > 0U; j--) {
+			if (compare_uuids(&toc[j - 1U].uuid, &tmp.uuid) <= 0)
+				break;
+			toc[j] = toc[j - 1U];
+			state->toc_index[j] = state->toc_index[j - 1U];
+		}
+		toc[j] = tmp;
+		state->toc_index[j] = (uint8_t)i;
+	}
+	state->toc_cache_count = count;
+
+	VERBOSE("FIP ToC cached (%u entries)\n", count);
+
+	return 0;
+}
+
+/*
+ * Binary search the cached ToC of a FIP device for the given UUID. Return the
+ * index of the matching cache entry, or -1 if not found.
+ */
+static int fip_toc_cache_find(const fip_dev_state_t *state,
+			      const uuid_t *uuid)
+{
+	unsigned int low = 0U;
+	unsigned int high = state->toc_cache_count;
+	unsigned int mid;
+	int cmp;
+
+	while (low < high) {
+		mid = low + ((high - low) / 2U);
+		cmp = compare_uuids(&state->toc_cache[mid].uuid, uuid);
+		if (cmp == 0)
+			return (int)mid;
+		if (cmp < 0)
+			low = mid + 1U;
+		else
+			high = mid;
+	}
+
+	return -1;
+}
+
 
 /* TODO: We could check version numbers or do a package checksum? */
 static inline int is_valid_header(fip_toc_header_t *header)
@@ -182,8 +307,8 @@ static int free_dev_info(io_dev_info_t *dev_info)
 
 /*
  * Multiple FIP devices can be opened depending on the value of
- * MAX_FIP_DEVICES. Given that there is only one backend, only a
- * single file can be open at a time by any FIP device.
+ * MAX_FIP_DEVICES. Up to PLAT_FIP_MAX_OPEN_FILES files can be open
+ * at a time across all FIP devices.
  */
 static int fip_dev_open(const uintptr_t dev_spec,
 			 io_dev_info_t **dev_info)
@@ -211,6 +336,58 @@ static int fip_dev_open(const uintptr_t dev_spec,
 }
 
 
+/* Allocate a file state from the pool and return a pointer to it */
+static file_state_t *allocate_file_state(void)
+{
+	unsigned int index;
+
+	for (index = 0U; index < (unsigned int)PLAT_FIP_MAX_OPEN_FILES;
+	     ++index) {
+		if (file_pool[index].entry.offset_address == 0U)
+			return &file_pool[index];
+	}
+
+	return NULL;
+}
+
+/* Get a backend entity positioned at 'offset' in the FIP */
+static int fip_backend_open(const fip_dev_state_t *state, size_t offset,
+			    uintptr_t *backend_handle)
+{
+	int result;
+
+#if PLAT_FIP_PERSISTENT_BACKEND
+	assert(state->backend_handle != (uintptr_t)NULL);
+	*backend_handle = state->backend_handle;
+#else
+	result = io_open(state->backend_dev_handle, state->backend_image_spec,
+			 backend_handle);
+	if (result != 0) {
+		WARN("Failed to open Firmware Image Package (%i)\n", result);
+		return -ENOENT;
+	}
+#endif
+
+	result = io_seek(*backend_handle, IO_SEEK_SET, (ssize_t)offset);
+	if (result != 0) {
+		WARN("fip: failed to seek backend\n");
+#if !PLAT_FIP_PERSISTENT_BACKEND
+		io_close(*backend_handle);
+#endif
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+/* Release a backend entity obtained through fip_backend_open() */
+static void fip_backend_close(uintptr_t backend_handle)
+{
+#if !PLAT_FIP_PERSISTENT_BACKEND
+	io_close(backend_handle);
+#endif
+}
+
 /* Do some basic package checks. */
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 {
@@ -219,10 +396,29 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 	uintptr_t backend_handle;
 	fip_toc_header_t header;
 	size_t bytes_read;
+	fip_dev_state_t *state = (fip_dev_state_t *)dev_info->info;
+
+#if KEEP_IO_DEV_OPEN
+	/*
+	 * The connection is kept open across images, so the header and ToC
+	 * read by a previous initialisation are still valid.
+	 */
+	if ((state->init_done != 0U) && (state->init_image_id == image_id))
+		return 0;
+#endif
+	state->init_done = 0U;
+
+#if PLAT_FIP_PERSISTENT_BACKEND
+	/* Re-initialisation, release the backend entity opened previously */
+	if (state->backend_handle != (uintptr_t)NULL) {
+		io_close(state->backend_handle);
+		state->backend_handle = (uintptr_t)NULL;
+	}
+#endif
 
 	/* Obtain a reference to the image by querying the platform layer */
-	result = plat_get_image_source(image_id, &backend_dev_handle,
-				       &backend_image_spec);
+	result = plat_get_image_source(image_id, &state->backend_dev_handle,
+				       &state->backend_image_spec);
 	if (result != 0) {
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
 			image_id, result);
@@ -231,7 +427,7 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 	}
 
 	/* Attempt to access the FIP image */
-	result = io_open(backend_dev_handle, backend_image_spec,
+	result = io_open(state->backend_dev_handle, state->backend_image_spec,
 			 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to access image id=%u (%i)\n", image_id, result);
@@ -247,9 +443,24 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			result = -ENOENT;
 		} else {
 			VERBOSE("FIP header looks OK.\n");
+			result = fip_toc_cache_fill(state, backend_handle);
+			if (result != 0)
+				result = -ENOENT;
 		}
 	}
 
+	if (result == 0) {
+		state->init_done = 1U;
+		state->init_image_id = image_id;
+	}
+
+#if PLAT_FIP_PERSISTENT_BACKEND
+	if (result == 0) {
+		/* Keep the backend open until fip_dev_close() */
+		state->backend_handle = backend_handle;
+		goto fip_dev_init_exit;
+	}
+#endif
 	io_close(backend_handle);
 
  fip_dev_init_exit:
@@ -261,10 +472,14 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 {
 	/* TODO: Consider tracking open files and cleaning them up here */
 
-	/* Clear the backend. */
-	backend_dev_handle = (uintptr_t)NULL;
-	backend_image_spec = (uintptr_t)NULL;
+#if PLAT_FIP_PERSISTENT_BACKEND
+	fip_dev_state_t *state = (fip_dev_state_t *)dev_info->info;
 
+	if (state->backend_handle != (uintptr_t)NULL)
+		io_close(state->backend_handle);
+#endif
+
+	/* Clear the backend with the rest of the device state. */
 	return free_dev_info(dev_info);
 }
 
@@ -276,73 +491,86 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	int result;
 	uintptr_t backend_handle;
 	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
+	const fip_dev_state_t *state;
+	file_state_t *fp;
+	int cached;
 	size_t bytes_read;
 	int found_file = 0;
 
+	assert(dev_info != NULL);
 	assert(uuid_spec != NULL);
 	assert(entity != NULL);
 
-	/* Can only have one file open at a time for the moment. We need to
-	 * track state like file cursor position. We know the header lives at
-	 * offset zero, so this entry should never be zero for an active file.
-	 * When the system supports dynamic memory allocation we can allow more
-	 * than one open file at a time if needed.
+	/*
+	 * Each open file needs its own state to track the file cursor
+	 * position, taken from a fixed size pool.
 	 */
-	if (current_file.entry.offset_address != 0) {
-		WARN("fip_file_open : Only one open file at a time.\n");
+	fp = allocate_file_state();
+	if (fp == NULL) {
+		WARN("fip_file_open : Too many open files.\n");
 		return -ENOMEM;
 	}
 
-	/* Attempt to access the FIP image */
-	result = io_open(backend_dev_handle, backend_image_spec,
-			 &backend_handle);
-	if (result != 0) {
-		WARN("Failed to open Firmware Image Package (%i)\n", result);
-		result = -ENOENT;
-		goto fip_file_open_exit;
+	state = (fip_dev_state_t *)dev_info->info;
+	cached = fip_toc_cache_find(state, &uuid_spec->uuid);
+	if (cached >= 0) {
+		/*
+		 * Each hit saves the backend reads of all the ToC entries up
+		 * to and including the matching one.
+		 */
+		fip_toc_reads_saved += state->toc_index[cached] + 1U;
+		VERBOSE("FIP ToC cache hit, %u backend reads saved\n",
+			fip_toc_reads_saved);
+		fp->entry = state->toc_cache[cached];
+		fp->file_pos = 0;
+		entity->info = (uintptr_t)fp;
+		return 0;
 	}
 
-	/* Seek past the FIP header into the Table of Contents */
-	result = io_seek(backend_handle, IO_SEEK_SET, sizeof(fip_toc_header_t));
-	if (result != 0) {
-		WARN("fip_file_open: failed to seek\n");
-		result = -ENOENT;
-		goto fip_file_open_close;
+	if (state->toc_cache_partial == 0U) {
+		/* The whole ToC is cached, so the file is not in the FIP. */
+		return -ENOENT;
 	}
 
+	/* Access the FIP image past the header, into the Table of Contents */
+	result = fip_backend_open(state, sizeof(fip_toc_header_t),
+				  &backend_handle);
+	if (result != 0)
+		goto fip_file_open_exit;
+
 	found_file = 0;
 	do {
 		result = io_read(backend_handle,
-				 (uintptr_t)&current_file.entry,
-				 sizeof(current_file.entry),
+				 (uintptr_t)&fp->entry,
+				 sizeof(fp->entry),
 				 &bytes_read);
 		if (result == 0) {
-			if (compare_uuids(&current_file.entry.uuid,
+			if (compare_uuids(&fp->entry.uuid,
 					  &uuid_spec->uuid) == 0) {
 				found_file = 1;
 				break;
 			}
 		} else {
 			WARN("Failed to read FIP (%i)\n", result);
-			goto fip_file_open_close;
+			break;
 		}
-	} while (compare_uuids(&current_file.entry.uuid, &uuid_null) != 0);
+	} while (compare_uuids(&fp->entry.uuid, &uuid_null) != 0);
 
 	if (found_file == 1) {
 		/* All fine. Update entity info with file state and return. Set
-		 * the file position to 0. The 'current_file.entry' holds the
-		 * base and size of the file.
+		 * the file position to 0. The 'fp->entry' holds the base and
+		 * size of the file.
 		 */
-		current_file.file_pos = 0;
-		entity->info = (uintptr_t)&current_file;
+		fp->file_pos = 0;
+		entity->info = (uintptr_t)fp;
 	} else {
-		/* Did not find the file in the FIP. */
-		current_file.entry.offset_address = 0;
-		result = -ENOENT;
+		/* Did not find the file in the FIP, release the file state. */
+		fp->entry.offset_address = 0;
+		if (result == 0)
+			result = -ENOENT;
 	}
 
- fip_file_open_close:
-	io_close(backend_handle);
+	fip_backend_close(backend_handle);
 
  fip_file_open_exit:
 	return result;
@@ -375,41 +603,28 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	assert(length_read != NULL);
 	assert(entity->info != (uintptr_t)NULL);
 
-	/* Open the backend, attempt to access the blob image */
-	result = io_open(backend_dev_handle, backend_image_spec,
-			 &backend_handle);
-	if (result != 0) {
-		WARN("Failed to open FIP (%i)\n", result);
-		result = -ENOENT;
-		goto fip_file_read_exit;
-	}
-
 	fp = (file_state_t *)entity->info;
 
-	/* Seek to the position in the FIP where the payload lives */
+	/* Access the FIP at the position where the payload lives */
 	file_offset = fp->entry.offset_address + fp->file_pos;
-	result = io_seek(backend_handle, IO_SEEK_SET, file_offset);
-	if (result != 0) {
-		WARN("fip_file_read: failed to seek\n");
-		result = -ENOENT;
-		goto fip_file_read_close;
-	}
+	result = fip_backend_open((fip_dev_state_t *)entity->dev_handle->info,
+				  file_offset, &backend_handle);
+	if (result != 0)
+		goto fip_file_read_exit;
 
 	result = io_read(backend_handle, buffer, length, &bytes_read);
 	if (result != 0) {
 		/* We cannot read our data. Fail. */
 		WARN("Failed to read payload (%i)\n", result);
 		result = -ENOENT;
-		goto fip_file_read_close;
 	} else {
 		/* Set caller length and new file position. */
 		*length_read = bytes_read;
 		fp->file_pos += bytes_read;
 	}
 
-/* Close the backend. */
- fip_file_read_close:
-	io_close(backend_handle);
+	/* Release the backend. */
+	fip_backend_close(backend_handle);
 
  fip_file_read_exit:
 	return result;
@@ -419,11 +634,11 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
-	/* Clear our current file pointer.
+	/* Release our file state back to the pool.
 	 * If we had malloc() we would free() here.
 	 */
-	if (current_file.entry.offset_address != 0) {
-		zeromem(&current_file, sizeof(current_file));
+	if (entity->info != (uintptr_t)NULL) {
+		zeromem((void *)entity->info, sizeof(file_state_t));
 	}
 
 	/* Clear the Entity info. */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RUNTIME_STATS_H__
+#define __RUNTIME_STATS_H__
+
+#include <utils_def.h>
+
+/*
+ * SMCs to read the runtime statistics of a CPU, in the SiP service call range
+ * next to the PMF calls. Platforms expose them by dispatching them to
+ * runtime_stats_smc_handler() from their SiP service.
+ */
+#define RUNTIME_STATS_SMC_GET_64	U(0xC2000030)
+#define RUNTIME_STATS_HIST_GET_64	U(0xC2000035)
+
+/* Kinds of statistics, selected by x2 of RUNTIME_STATS_SMC_GET_64 */
+#define RUNTIME_STATS_SMC		U(0)	/* By runtime service index */
+#define RUNTIME_STATS_INTR_TYPE		U(1)	/* By interrupt type */
+#define RUNTIME_STATS_INTR_ID		U(2)	/* By EL3 interrupt ID */
+
+/*
+ * Buckets of the histogram of the time spent handling each event, in system
+ * counter ticks. Bucket 0 counts the times of 0, and bucket N the times from
+ * 2^(N-1) to 2^N - 1. The last bucket also counts all the longer times.
+ */
+#define RUNTIME_STATS_HIST_BUCKETS	U(16)
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+void runtime_stats_smc(unsigned int index, unsigned long long start);
+void runtime_stats_intr_type(unsigned int type, unsigned long long start);
+void runtime_stats_intr_id(unsigned int id, unsigned long long start);
+uintptr_t runtime_stats_smc_handler(uint32_t smc_fid,
+				    u_register_t x1,
+				    u_register_t x2,
+				    u_register_t x3,
+				    u_register_t x4,
+				    void *cookie,
+				    void *handle,
+				    u_register_t flags);
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* __RUNTIME_STATS_H__ */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __BL2_WORK_H__
+#define __BL2_WORK_H__
+
+#include <cdefs.h>
+#include <stdint.h>
+
+/*
+ * States of a BL2 work item. A work item that has never been submitted, or
+ * that has been zero-initialised, is idle.
+ */
+#define BL2_WORK_IDLE		0U
+#define BL2_WORK_QUEUED		1U
+#define BL2_WORK_RUNNING	2U
+#define BL2_WORK_DONE		3U
+
+typedef int (*bl2_work_func_t)(void *arg);
+
+/*
+ * A unit of work that BL2 may run on any core. The storage for the work item
+ * is provided by the caller and must stay valid until the work is done.
+ */
+typedef struct bl2_work {
+	bl2_work_func_t func;
+	void *arg;
+
+	/*
+	 * Optional work item that must be done before this one is started.
+	 * It must have been submitted before this one.
+	 */
+	const struct bl2_work *after;
+
+	volatile unsigned int state;
+	int ret;
+} bl2_work_t;
+
+void bl2_work_start(void);
+void bl2_work_submit(bl2_work_t *work, bl2_work_func_t func, void *arg,
+		     const bl2_work_t *after);
+int bl2_work_wait(bl2_work_t *work);
+int bl2_work_barrier(void);
+int bl2_work_error(void);
+int bl2_work_finish(void);
+
+void bl2_work_console_lock(void);
+void bl2_work_console_unlock(void);
+
+void bl2_work_entrypoint(void) __dead2;
+void bl2_work_secondary_main(void) __dead2;
+
+#endif /* __BL2_WORK_H__ */
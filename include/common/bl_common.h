@@ -178,6 +178,7 @@ int is_mem_free(uintptr_t free_base, size_t free_size,
 		uintptr_t addr, size_t size);
 
 int load_auth_image(unsigned int image_id, image_info_t *image_data);
+void close_image_devices(void);
 
 #if TRUSTED_BOARD_BOOT && defined(DYN_DISABLE_AUTH)
 /*
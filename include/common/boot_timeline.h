@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __BOOT_TIMELINE_H__
+#define __BOOT_TIMELINE_H__
+
+#include <utils_def.h>
+
+/*
+ * Boot timeline event IDs. The per-image events are captured for images with
+ * an ID lower than BOOT_TIMELINE_MAX_IMAGES and are identified by
+ * BOOT_TIMELINE_IMG_ID().
+ */
+#define BOOT_TIMELINE_BL1_ENTRY		U(0)
+#define BOOT_TIMELINE_BL1_EXIT		U(1)
+#define BOOT_TIMELINE_BL2_ENTRY		U(2)
+#define BOOT_TIMELINE_BL2_EXIT		U(3)
+#define BOOT_TIMELINE_BL31_ENTRY	U(4)
+#define BOOT_TIMELINE_BL31_EXIT		U(5)
+#define BOOT_TIMELINE_DDR_INIT_START	U(6)
+#define BOOT_TIMELINE_DDR_INIT_END	U(7)
+#define BOOT_TIMELINE_IMG_BASE		U(8)
+
+/* Events captured for each image */
+#define BOOT_TIMELINE_IMG_LOAD_START	U(0)	/* load_auth_image() entry */
+#define BOOT_TIMELINE_IMG_LOAD_END	U(1)	/* I/O done */
+#define BOOT_TIMELINE_IMG_AUTH_END	U(2)	/* Hash or signature checked */
+#define BOOT_TIMELINE_IMG_POST_START	U(3)	/* Post-load handling, e.g. */
+#define BOOT_TIMELINE_IMG_POST_END	U(4)	/* decompression */
+#define BOOT_TIMELINE_IMG_EVENTS	U(5)
+
+#define BOOT_TIMELINE_MAX_IMAGES	U(32)
+
+#define BOOT_TIMELINE_IMG_ID(_image_id, _event)				\
+	(BOOT_TIMELINE_IMG_BASE +					\
+	 ((_image_id) * BOOT_TIMELINE_IMG_EVENTS) + (_event))
+
+#define BOOT_TIMELINE_TOTAL_IDS						\
+	(BOOT_TIMELINE_IMG_BASE +					\
+	 (BOOT_TIMELINE_MAX_IMAGES * BOOT_TIMELINE_IMG_EVENTS))
+
+/*
+ * Size of the memory reserved by the platform at PLAT_BOOT_TIMELINE_BASE: a
+ * 64-bit header followed by a 64-bit time-stamp per event.
+ */
+#define BOOT_TIMELINE_SIZE						\
+	(8U * (1U + BOOT_TIMELINE_TOTAL_IDS))
+
+#ifndef __ASSEMBLY__
+
+#if ENABLE_BOOT_TIMELINE
+void boot_timeline_init(void);
+void boot_timeline_capture(unsigned int tid);
+void boot_timeline_capture_image(unsigned int image_id, unsigned int event);
+unsigned long long boot_timeline_get(unsigned int tid);
+void boot_timeline_print(void);
+
+#define BOOT_TIMELINE_CAPTURE(_tid)					\
+	boot_timeline_capture(_tid)
+#define BOOT_TIMELINE_CAPTURE_IMAGE(_image_id, _event)			\
+	boot_timeline_capture_image((_image_id), (_event))
+#else
+#define BOOT_TIMELINE_CAPTURE(_tid)
+#define BOOT_TIMELINE_CAPTURE_IMAGE(_image_id, _event)
+#endif /* ENABLE_BOOT_TIMELINE */
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* __BOOT_TIMELINE_H__ */
@@ -18,6 +18,10 @@ typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
+#if BL2_PARALLEL_WORK
+void image_decompress_add_buf(uintptr_t buf_base, uint32_t buf_size);
+int image_decompress_wait(struct image_info *info);
+#endif
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
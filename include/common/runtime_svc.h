@@ -11,6 +11,9 @@
 #include <cassert.h>
 #include <smccc_helpers.h>	/* to include SMCCC definitions */
 #include <utils_def.h>
+#if ENABLE_RT_SVC_FID_STATS
+#include <platform_def.h>
+#endif
 
 /*******************************************************************************
  * Structure definition, typedefs & constants for the runtime service framework
@@ -20,6 +23,7 @@
  * Constants to allow the assembler access a runtime service
  * descriptor
  */
+#define RT_SVC_DESC_FLAGS	3
 #ifdef AARCH32
 #define RT_SVC_SIZE_LOG2	4
 #define RT_SVC_DESC_INIT	8
@@ -31,6 +35,23 @@
 #endif /* AARCH32 */
 #define SIZEOF_RT_SVC_DESC	(1 << RT_SVC_SIZE_LOG2)
 
+/*
+ * Runtime service flags
+ *
+ * RT_SVC_FLAG_LEAF: all the calls of the service are leaf calls, which BL31
+ * handles without saving the complete general purpose register context of the
+ * caller. A leaf handler:
+ *  - must only be called as a fast SMC;
+ *  - must return its results through SMC_RET0() to SMC_RET8();
+ *  - may read x0 to x18 of the caller from the context, but no other register;
+ *  - must not modify the EL3 state of the context, nor switch to another
+ *    context or security state;
+ *  - must not unmask interrupts.
+ * On AArch32, and for services not flagged, all calls take the normal path.
+ */
+#define RT_SVC_FLAG_LEAF_SHIFT	0
+#define RT_SVC_FLAG_LEAF	(U(1) << RT_SVC_FLAG_LEAF_SHIFT)
+
 
 /*
  * In SMCCC 1.X, the function identifier has 6 bits for the owning entity number
@@ -75,6 +96,7 @@ typedef struct rt_svc_desc {
 #elif SMCCC_MAJOR_VERSION == 2
 	uint8_t is_vendor;
 #endif
+	uint8_t flags;
 	const char *name;
 	rt_svc_init_t init;
 	rt_svc_handle_t handle;
@@ -85,12 +107,14 @@ typedef struct rt_svc_desc {
  */
 #if SMCCC_MAJOR_VERSION == 1
 
-#define DECLARE_RT_SVC(_name, _start, _end, _type, _setup, _smch)	\
+#define DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, _flags,	\
+			     _setup, _smch)				\
 	static const rt_svc_desc_t __svc_desc_ ## _name			\
 		__section("rt_svc_descs") __used = {			\
 			.start_oen = _start,				\
 			.end_oen = _end,				\
 			.call_type = _type,				\
+			.flags = _flags,				\
 			.name = #_name,					\
 			.init = _setup,					\
 			.handle = _smch					\
@@ -98,12 +122,14 @@ typedef struct rt_svc_desc {
 
 #elif SMCCC_MAJOR_VERSION == 2
 
-#define DECLARE_RT_SVC(_name, _start, _end, _type, _setup, _smch)	\
+#define DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, _flags,	\
+			     _setup, _smch)				\
 	static const rt_svc_desc_t __svc_desc_ ## _name			\
 		__section("rt_svc_descs") __used = {			\
 			.start_oen = _start,				\
 			.end_oen = _end,				\
 			.is_vendor = 0,					\
+			.flags = _flags,				\
 			.name = #_name,					\
 			.init = _setup,					\
 			.handle = _smch,				\
@@ -127,6 +153,62 @@ typedef struct rt_svc_desc {
 
 #endif /* SMCCC_MAJOR_VERSION */
 
+#define DECLARE_RT_SVC(_name, _start, _end, _type, _setup, _smch)	\
+	DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, 0U, _setup, _smch)
+
+/* Declare a service whose calls are all leaf calls (see RT_SVC_FLAG_LEAF) */
+#define DECLARE_RT_SVC_LEAF(_name, _start, _end, _type, _setup, _smch)	\
+	DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, RT_SVC_FLAG_LEAF, \
+			     _setup, _smch)
+
+/*
+ * A runtime service can dispatch its calls with tables of function IDs and
+ * handlers, instead of testing the function ID itself. The entries of a table
+ * must be sorted by ascending function ID. A table whose function IDs are
+ * consecutive is indexed directly, other tables are searched by bisection.
+ * Services can use tables for some of their calls only, and handle the others
+ * as before.
+ */
+typedef struct rt_svc_fid {
+	uint32_t fid;
+	rt_svc_handle_t handle;
+} rt_svc_fid_t;
+
+typedef struct rt_svc_fid_table {
+	const char *name;
+	const rt_svc_fid_t *fids;
+	unsigned int num_fids;
+#if ENABLE_RT_SVC_FID_STATS
+	/* Number of calls to each function, for each CPU */
+	unsigned int *counts;
+#endif
+} rt_svc_fid_table_t;
+
+#if ENABLE_RT_SVC_FID_STATS
+#define RT_SVC_FID_COUNTS(_name, _fids)					\
+	static unsigned int __svc_fid_counts_ ## _name			\
+		[PLATFORM_CORE_COUNT * ARRAY_SIZE(_fids)];
+#define RT_SVC_FID_COUNTS_INIT(_name)					\
+	.counts = __svc_fid_counts_ ## _name,
+#else
+#define RT_SVC_FID_COUNTS(_name, _fids)
+#define RT_SVC_FID_COUNTS_INIT(_name)
+#endif
+
+/*
+ * Declare the table `_name` for the array of rt_svc_fid_t `_fids`. The table
+ * is registered so that it is checked by runtime_svc_init().
+ */
+#define DECLARE_RT_SVC_FIDS(_name, _fids)				\
+	RT_SVC_FID_COUNTS(_name, _fids)					\
+	static const rt_svc_fid_table_t _name				\
+		__section("rt_svc_fid_tables") __used = {		\
+			.name = #_name,					\
+			.fids = _fids,					\
+			.num_fids = ARRAY_SIZE(_fids),			\
+			RT_SVC_FID_COUNTS_INIT(_name)			\
+		}
+
 /*
  * Compile time assertions related to the 'rt_svc_desc' structure to:
  * 1. ensure that the assembler and the compiler view of the size
@@ -135,6 +217,8 @@ typedef struct rt_svc_desc {
  *    routine at the same offset.
  * 3. ensure that the assembler and the compiler see the handler
  *    routine at the same offset.
+ * 4. ensure that the assembler and the compiler see the flags at the same
+ *    offset.
  */
 CASSERT((sizeof(rt_svc_desc_t) == SIZEOF_RT_SVC_DESC), \
 	assert_sizeof_rt_svc_desc_mismatch);
@@ -142,6 +226,8 @@ CASSERT(RT_SVC_DESC_INIT == __builtin_offsetof(rt_svc_desc_t, init), \
 	assert_rt_svc_desc_init_offset_mismatch);
 CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 	assert_rt_svc_desc_handle_offset_mismatch);
+CASSERT(RT_SVC_DESC_FLAGS == __builtin_offsetof(rt_svc_desc_t, flags), \
+	assert_rt_svc_desc_flags_offset_mismatch);
 
 
 #if SMCCC_MAJOR_VERSION == 1
@@ -186,6 +272,13 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid, void *cookie, void *handle,
 						unsigned int flags);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_TABLES_START__,	RT_SVC_FID_TABLES_START);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_TABLES_END__,	RT_SVC_FID_TABLES_END);
+rt_svc_handle_t rt_svc_fid_lookup(const rt_svc_fid_table_t *table,
+				  uint32_t smc_fid);
+#if ENABLE_RT_SVC_FID_STATS
+unsigned long long rt_svc_fid_call_count(uint32_t smc_fid);
+#endif
 void init_crash_reporting(void);
 
 extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
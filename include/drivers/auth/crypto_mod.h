@@ -37,6 +37,16 @@ typedef struct crypto_lib_desc_s {
 	/* Verify a hash. Return one of the 'enum crypto_ret_value' options */
 	int (*verify_hash)(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+
+	/* Optional incremental hash verification. Only one calculation can be
+	 * in progress at a time. 'hash_start' takes the hash to be compared,
+	 * 'hash_update' hashes a block of data and 'hash_finish' compares the
+	 * result and releases the calculation. Return one of the
+	 * 'enum crypto_ret_value' options */
+	int (*verify_hash_start)(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+	int (*verify_hash_update)(void *data_ptr, unsigned int data_len);
+	int (*verify_hash_finish)(void);
 } crypto_lib_desc_t;
 
 /* Public functions */
@@ -47,6 +57,12 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 				void *pk_ptr, unsigned int pk_len);
 int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+#if AUTH_STREAM_HASH
+int crypto_mod_verify_hash_start(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+int crypto_mod_verify_hash_update(void *data_ptr, unsigned int data_len);
+int crypto_mod_verify_hash_finish(void);
+#endif
 
 /* Macro to register a cryptographic library */
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash) \
@@ -57,6 +73,20 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 		.verify_hash = _verify_hash \
 	}
 
+/* Macro to register a cryptographic library with incremental hashing */
+#define REGISTER_CRYPTO_LIB_STREAM(_name, _init, _verify_signature, \
+				   _verify_hash, _verify_hash_start, \
+				   _verify_hash_update, _verify_hash_finish) \
+	const crypto_lib_desc_t crypto_lib_desc = { \
+		.name = _name, \
+		.init = _init, \
+		.verify_signature = _verify_signature, \
+		.verify_hash = _verify_hash, \
+		.verify_hash_start = _verify_hash_start, \
+		.verify_hash_update = _verify_hash_update, \
+		.verify_hash_finish = _verify_hash_finish \
+	}
+
 extern const crypto_lib_desc_t crypto_lib_desc;
 
 #endif /* __CRYPTO_MOD_H__ */
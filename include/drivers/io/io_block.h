@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,10 +15,20 @@ typedef struct io_block_ops {
 	size_t	(*write)(int lba, const uintptr_t buf, size_t size);
 } io_block_ops_t;
 
+/*
+ * Flags describing the capabilities of a block device.
+ *
+ * IO_BLOCK_FLAG_DIRECT_XFER: ops->read and ops->write can transfer whole
+ * blocks directly to/from any block-aligned buffer passed by the IO caller,
+ * not only to/from the bounce buffer.
+ */
+#define IO_BLOCK_FLAG_DIRECT_XFER	(1U << 0)
+
 typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+	unsigned int	flags;
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
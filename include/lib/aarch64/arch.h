@@ -136,6 +136,11 @@
 #define ID_AA64PFR0_GIC_WIDTH	U(4)
 #define ID_AA64PFR0_GIC_MASK	((ULL(1) << ID_AA64PFR0_GIC_WIDTH) - ULL(1))
 
+/* ID_AA64ISAR0_EL1 definitions */
+#define ID_AA64ISAR0_TLB_SHIFT	U(56)
+#define ID_AA64ISAR0_TLB_MASK	ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE	ULL(0x2)
+
 /* ID_AA64MMFR0_EL1 definitions */
 #define ID_AA64MMFR0_EL1_PARANGE_SHIFT	U(0)
 #define ID_AA64MMFR0_EL1_PARANGE_MASK	ULL(0xf)
@@ -550,6 +555,25 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the TLBI range operations of ARMv8.4-TLBI for a 4KB granule. The
+ * operation covers (NUM + 1) * 2^(5 * SCALE + 1) pages from the base address.
+ */
+#define TLBI_RANGE_TG_4KB	ULL(1)
+#define TLBI_RANGE_TG_SHIFT	U(46)
+#define TLBI_RANGE_SCALE_SHIFT	U(44)
+#define TLBI_RANGE_SCALE_MAX	U(3)
+#define TLBI_RANGE_NUM_SHIFT	U(39)
+#define TLBI_RANGE_NUM_MAX	U(31)
+#define TLBI_RANGE_BADDR_MASK	ULL(0x0000001FFFFFFFFF)
+#define TLBI_RANGE_PAGES(num, scale)	\
+	((unsigned long long)((num) + 1U) << ((5U * (scale)) + 1U))
+#define TLBI_RANGE_ADDR(x, num, scale)					\
+	((TLBI_RANGE_TG_4KB << TLBI_RANGE_TG_SHIFT) |			\
+	 ((unsigned long long)(scale) << TLBI_RANGE_SCALE_SHIFT) |	\
+	 ((unsigned long long)(num) << TLBI_RANGE_NUM_SHIFT) |		\
+	 (((x) >> TLBI_ADDR_SHIFT) & TLBI_RANGE_BADDR_MASK))
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
@@ -123,6 +123,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3is)
 #endif
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vaae1is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vaale1is)
@@ -136,6 +137,20 @@ DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vae3is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vale3is)
 #endif
 
+/*
+ * TLBI range operations of ARMv8.4-TLBI. They are written in their SYS form so
+ * that they build with assemblers that don't know about them.
+ */
+#define DEFINE_TLBIOP_RANGE_PARAM_FUNC(_type, _op1, _op2)		\
+static inline void tlbi ## _type(uint64_t v)				\
+{									\
+	__asm__("sys #" #_op1 ", c8, c2, #" #_op2 ", %0" : : "r" (v));	\
+}
+
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvaae1is, 0, 3)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae2is, 4, 1)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae3is, 6, 1)
+
 /*******************************************************************************
  * Cache maintenance accessor prototypes
  ******************************************************************************/
@@ -219,6 +234,7 @@ void __dead2 smc(uint64_t x0, uint64_t x1, uint64_t x2, uint64_t x3,
  ******************************************************************************/
 DEFINE_SYSREG_READ_FUNC(midr_el1)
 DEFINE_SYSREG_READ_FUNC(mpidr_el1)
+DEFINE_SYSREG_READ_FUNC(id_aa64isar0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64mmfr0_el1)
 
 DEFINE_SYSREG_RW_FUNCS(scr_el3)
@@ -332,6 +332,10 @@ CASSERT(CTX_CVE_2018_3639_OFFSET == __builtin_offsetof(cpu_context_t, cve_2018_3
  ******************************************************************************/
 void el1_sysregs_context_save(el1_sys_regs_t *regs);
 void el1_sysregs_context_restore(el1_sys_regs_t *regs);
+#if CTX_LAZY_EL1_SYSREGS
+void el1_sysregs_context_restore_lazy(el1_sys_regs_t *regs,
+				      const el1_sys_regs_t *live_regs);
+#endif
 #if CTX_INCLUDE_FPREGS
 void fpregs_context_save(fp_regs_t *regs);
 void fpregs_context_restore(fp_regs_t *regs);
@@ -52,6 +52,8 @@
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
+#define PMF_BOOT_TIMELINE_SVC_ID	2
+#define PMF_RT_INSTR_CTX_SVC_ID	3
 
 #if ENABLE_PMF
 /*
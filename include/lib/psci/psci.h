@@ -7,6 +7,7 @@
 #ifndef PSCI_H
 #define PSCI_H
 
+#include <arch.h>
 #include <bakery_lock.h>
 #include <bl_common.h>
 #include <platform_def.h>	/* for PLAT_NUM_PWR_DOMAINS */
@@ -83,6 +84,13 @@
 #define is_psci_fid(_fid) \
 	(((_fid) & PSCI_FID_MASK) == PSCI_FID_VALUE)
 
+/*
+ * SMC to power on several CPUs with the same entry point, in the SiP service
+ * call range. Platforms expose it by dispatching it to
+ * psci_cpu_on_multi_smc_handler() from their SiP service.
+ */
+#define PSCI_CPU_ON_MULTI_64		U(0xC2000033)
+
 /*******************************************************************************
  * PSCI Migrate and friends
  ******************************************************************************/
@@ -227,6 +235,18 @@ typedef uint8_t plat_local_state_t;
 /* The local state macro used to represent RUN state. */
 #define PSCI_LOCAL_STATE_RUN	U(0)
 
+/*
+ * Return the mpidr of the CPU which stands for bit `n` of a CPU_ON_MULTI
+ * bitmap: the affinity field `aff_lvl` of `base_mpidr` is set to `n`.
+ */
+static inline u_register_t psci_cpu_on_multi_mpidr(u_register_t base_mpidr,
+						   unsigned int aff_lvl,
+						   unsigned int n)
+{
+	return base_mpidr |
+	       ((u_register_t)n << (aff_lvl * MPIDR_AFFINITY_BITS));
+}
+
 /*
  * Function to test whether the plat_local_state is RUN state
  */
@@ -322,6 +342,8 @@ typedef struct plat_psci_ops {
 	int (*write_mem_protect)(int val);
 	int (*system_reset2)(int is_vendor,
 				int reset_type, u_register_t cookie);
+	uint64_t (*pwr_domain_on_multi)(u_register_t base_mpidr,
+				unsigned int aff_lvl, uint64_t targets);
 } plat_psci_ops_t;
 
 /*******************************************************************************
@@ -344,6 +366,16 @@ u_register_t psci_migrate_info_up_cpu(void);
 int psci_node_hw_state(u_register_t target_cpu,
 		       unsigned int power_level);
 int psci_features(unsigned int psci_fid);
+#ifndef AARCH32
+uintptr_t psci_cpu_on_multi_smc_handler(uint32_t smc_fid,
+					u_register_t x1,
+					u_register_t x2,
+					u_register_t x3,
+					u_register_t x4,
+					void *cookie,
+					void *handle,
+					u_register_t flags);
+#endif
 void __dead2 psci_power_down_wfi(void);
 void psci_arch_setup(void);
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __PSCI_STAT_HIST_H__
+#define __PSCI_STAT_HIST_H__
+
+#include <utils_def.h>
+
+/*
+ * SMCs to read and reset the PSCI idle state histograms, in the SiP service
+ * call range. Platforms expose them by dispatching them to
+ * psci_stat_hist_smc_handler() from their SiP service.
+ */
+#define PSCI_STAT_HIST_GET_64		U(0xC2000031)
+#define PSCI_STAT_HIST_RESET_64		U(0xC2000032)
+
+/* Histograms, selected by x3 of PSCI_STAT_HIST_GET_64 */
+#define PSCI_STAT_HIST_RESIDENCY	U(0)	/* In microseconds */
+#define PSCI_STAT_HIST_ENTRY_LATENCY	U(1)	/* In nanoseconds */
+#define PSCI_STAT_HIST_EXIT_LATENCY	U(2)	/* In nanoseconds */
+#define PSCI_STAT_HIST_TYPES		U(3)
+
+/*
+ * Bucket 0 counts the values of 0, and bucket N the values from 2^(N-1) to
+ * 2^N - 1. The last bucket also counts all the larger values.
+ */
+#define PSCI_STAT_HIST_BUCKETS		U(32)
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+void psci_stats_update_latency(void);
+uintptr_t psci_stat_hist_smc_handler(uint32_t smc_fid,
+				     u_register_t x1,
+				     u_register_t x2,
+				     u_register_t x3,
+				     u_register_t x4,
+				     void *cookie,
+				     void *handle,
+				     u_register_t flags);
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* __PSCI_STAT_HIST_H__ */
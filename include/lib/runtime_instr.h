@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,9 +15,22 @@
 #define RT_INSTR_EXIT_CFLUSH		5
 #define RT_INSTR_TOTAL_IDS		6
 
+/*
+ * The EL1 context management time-stamps have their own PMF service, so that
+ * they don't share a cache line with RT_INSTR_EXIT_HW_LOW_PWR, which is
+ * written with the data cache disabled on the warm boot path.
+ */
+#define RT_INSTR_ENTER_EL1_CTX_SAVE	0
+#define RT_INSTR_EXIT_EL1_CTX_SAVE	1
+#define RT_INSTR_ENTER_EL1_CTX_RESTORE	2
+#define RT_INSTR_EXIT_EL1_CTX_RESTORE	3
+#define RT_INSTR_CTX_TOTAL_IDS		4
+
 #ifndef __ASSEMBLY__
 PMF_DECLARE_CAPTURE_TIMESTAMP(rt_instr_svc)
 PMF_DECLARE_GET_TIMESTAMP(rt_instr_svc)
+PMF_DECLARE_CAPTURE_TIMESTAMP(rt_instr_ctx_svc)
+PMF_DECLARE_GET_TIMESTAMP(rt_instr_ctx_svc)
 #endif /* __ASSEMBLY__ */
 
 #endif /* __RUNTIME_INSTR_H__ */
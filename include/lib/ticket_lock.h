@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __TICKET_LOCK_H__
+#define __TICKET_LOCK_H__
+
+/*
+ * Ticket locks are granted in the order in which they are requested, and a
+ * contender waits for a single store to the lock, which makes them fairer
+ * than spin locks under contention. The lock word holds the next ticket to
+ * hand out in its upper half and the ticket being served in its lower half.
+ * As with spin locks, all contenders must be cache-coherent.
+ */
+#define TICKET_LOCK_NEXT_SHIFT	16
+#define TICKET_LOCK_OWNER_MASK	0xffff
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+typedef struct ticket_lock {
+	volatile uint32_t lock;
+} ticket_lock_t;
+
+void ticket_lock_get(ticket_lock_t *lock);
+void ticket_lock_release(ticket_lock_t *lock);
+
+#else
+
+/* Ticket lock definitions for use in assembly */
+#define TICKET_LOCK_ASM_ALIGN	2
+#define TICKET_LOCK_ASM_SIZE	4
+
+#endif
+
+#endif /* __TICKET_LOCK_H__ */
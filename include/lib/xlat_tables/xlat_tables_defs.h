@@ -43,6 +43,8 @@
 #define PAGE_DESC		U(0x3) /* Table level 3 */
 
 #define DESC_MASK		U(0x3)
+/* Descriptors with this bit cleared are invalid, whatever their other bits. */
+#define VALID_DESC		U(0x1)
 
 #define FIRST_LEVEL_DESC_N	ONE_GB_SHIFT
 #define SECOND_LEVEL_DESC_N	TWO_MB_SHIFT
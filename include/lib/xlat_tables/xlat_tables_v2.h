@@ -292,6 +292,9 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx,
  * NOTE2: The caller is responsible for making sure that the targeted
  * translation tables are not modified by any other code while this function is
  * executing.
+ *
+ * NOTE3: The whole memory region is unmapped while its attributes are being
+ * changed, so it must not be accessed in the meantime, e.g. by another CPU.
  */
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size, uint32_t attr);
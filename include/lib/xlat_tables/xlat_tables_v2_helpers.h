@@ -78,6 +78,11 @@ struct xlat_ctx {
 
 	int next_table;
 
+#if XLAT_TABLES_COALESCE
+	/* Number of subtables that have been replaced by block descriptors. */
+	int coalesced_tables;
+#endif
+
 	/*
 	 * Base translation table. It doesn't need to have the same amount of
 	 * entries as the ones used for other levels.
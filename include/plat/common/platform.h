@@ -75,6 +75,7 @@ int plat_ic_is_spi(unsigned int id);
 int plat_ic_is_ppi(unsigned int id);
 int plat_ic_is_sgi(unsigned int id);
 unsigned int plat_ic_get_interrupt_active(unsigned int id);
+unsigned int plat_ic_get_interrupt_pending(unsigned int id);
 void plat_ic_disable_interrupt(unsigned int id);
 void plat_ic_enable_interrupt(unsigned int id);
 int plat_ic_has_interrupt_type(unsigned int type);
@@ -178,7 +179,10 @@ int bl2_plat_handle_post_image_load(unsigned int image_id);
 /*******************************************************************************
  * Optional BL2 functions (may be overridden)
  ******************************************************************************/
-
+#if BL2_PARALLEL_WORK
+unsigned int plat_bl2_wake_secondaries(uintptr_t entrypoint);
+void plat_bl2_park_secondary(void) __dead2;
+#endif
 
 /*******************************************************************************
  * Mandatory BL2 at EL3 functions: Must be implemented if BL2_AT_EL3 image is
@@ -8,6 +8,7 @@
 #define SDEI_H
 
 #include <spinlock.h>
+#include <stdbool.h>
 #include <utils_def.h>
 
 /* Range 0xC4000020 - 0xC400003F reserved for SDE 64bit smc calls */
@@ -33,10 +34,28 @@
 #define SDEI_PRIVATE_RESET			0xC4000031U
 #define SDEI_SHARED_RESET			0xC4000032U
 
+/*
+ * SMC to read the dispatch statistics of an SDEI event, in the SiP service
+ * call range. Platforms expose it by dispatching it to sdei_stats_smc_handler()
+ * from their SiP service.
+ */
+#define SDEI_STATS_GET_64			U(0xC2000034)
+
 /* SDEI_EVENT_REGISTER flags */
 #define SDEI_REGF_RM_ANY	0ULL
 #define SDEI_REGF_RM_PE		1ULL
 
+/*
+ * Implementation defined extension for batched dispatch, available with
+ * SDEI_BATCH_DISPATCH. SDEI_FEATURES with SDEI_FEATURE_BATCH_DISPATCH returns
+ * the maximum number of events dispatched along with the triggered one, and
+ * events registered with SDEI_REGF_BATCH are dispatched together when they
+ * share the same handler.
+ */
+#define SDEI_FEATURE_BATCH_DISPATCH	0x80000000U
+#define SDEI_REGF_BATCH			(1ULL << 31)
+#define SDEI_BATCH_MAX_EVENTS		8U
+
 /* SDEI_EVENT_COMPLETE status flags */
 #define SDEI_EV_HANDLED		0U
 #define SDEI_EV_FAILED		1U
@@ -149,6 +168,21 @@ typedef struct sdei_entry {
 
 	/* Event handler states: registered, enabled, running */
 	sdei_state_t state;
+
+#if SDEI_BATCH_DISPATCH
+	/* Registered for batched dispatch */
+	bool batch;
+#endif
+
+#if ENABLE_SDEI_STATS
+	/*
+	 * Dispatches of the event from its interrupt, with their total and
+	 * longest latency in system counter ticks.
+	 */
+	uint64_t dispatch_count;
+	uint64_t dispatch_ticks;
+	uint64_t dispatch_max_ticks;
+#endif
 } sdei_entry_t;
 
 /* Mapping of SDEI events to interrupts, and associated data */
@@ -180,4 +214,15 @@ void sdei_init(void);
 /* Public API to dispatch an event to Normal world */
 int sdei_dispatch_event(int ev_num);
 
+#if ENABLE_SDEI_STATS
+uintptr_t sdei_stats_smc_handler(uint32_t smc_fid,
+				 u_register_t x1,
+				 u_register_t x2,
+				 u_register_t x3,
+				 u_register_t x4,
+				 void *cookie,
+				 void *handle,
+				 u_register_t flags);
+#endif
+
 #endif /* SDEI_H */
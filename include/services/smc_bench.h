@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __SMC_BENCH_H__
+#define __SMC_BENCH_H__
+
+#include <utils_def.h>
+
+/*
+ * SMC benchmark service, built with ENABLE_SMC_BENCHMARK. It uses the OEM
+ * service call range, so it can't be built with a platform that registers an
+ * OEM service of its own, like the MediaTek ones.
+ */
+#define SMC_BENCH_NULL_32		U(0x83000000)
+#define SMC_BENCH_NULL_64		U(0xC3000000)
+#define SMC_BENCH_TIMESTAMP_64		U(0xC3000001)
+#define SMC_BENCH_LOCK_64		U(0xC3000002)
+
+#define SMC_BENCH_CALL_COUNT		U(0x8300ff00)
+#define SMC_BENCH_VERSION		U(0x8300ff03)
+
+/* Number of benchmark calls, not counting the general queries */
+#define SMC_BENCH_NUM_CALLS		U(4)
+
+#define SMC_BENCH_VERSION_MAJOR		U(1)
+#define SMC_BENCH_VERSION_MINOR		U(1)
+
+/* Locks taken by SMC_BENCH_LOCK_64 */
+#define SMC_BENCH_SPIN_LOCK		U(0)
+#define SMC_BENCH_TICKET_LOCK		U(1)
+
+#endif /* __SMC_BENCH_H__ */
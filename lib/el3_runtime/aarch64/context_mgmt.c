@@ -15,7 +15,9 @@
 #include <mpam.h>
 #include <platform.h>
 #include <platform_def.h>
+#include <pmf.h>
 #include <pubsub_events.h>
+#include <runtime_instr.h>
 #include <smccc_helpers.h>
 #include <spe.h>
 #include <string.h>
@@ -463,8 +465,20 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx);
 
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_ENTER_EL1_CTX_SAVE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
 	el1_sysregs_context_save(get_sysregs_ctx(ctx));
 
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_EXIT_EL1_CTX_SAVE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
 #if IMAGE_BL31
 	if (security_state == SECURE)
 		PUBLISH_EVENT(cm_exited_secure_world);
@@ -473,6 +487,16 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 #endif
 }
 
+static void cm_el1_sysregs_context_restored(uint32_t security_state)
+{
+#if IMAGE_BL31
+	if (security_state == SECURE)
+		PUBLISH_EVENT(cm_entering_secure_world);
+	else
+		PUBLISH_EVENT(cm_entering_normal_world);
+#endif
+}
+
 void cm_el1_sysregs_context_restore(uint32_t security_state)
 {
 	cpu_context_t *ctx;
@@ -480,13 +504,62 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx);
 
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_ENTER_EL1_CTX_RESTORE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
 	el1_sysregs_context_restore(get_sysregs_ctx(ctx));
 
-#if IMAGE_BL31
-	if (security_state == SECURE)
-		PUBLISH_EVENT(cm_entering_secure_world);
-	else
-		PUBLISH_EVENT(cm_entering_normal_world);
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_EXIT_EL1_CTX_RESTORE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
+	cm_el1_sysregs_context_restored(security_state);
+}
+
+/*******************************************************************************
+ * This function restores the EL1 context of the specified security state like
+ * cm_el1_sysregs_context_restore(). It may only be called when the EL1 system
+ * registers hold the values saved in the context of the other security state,
+ * that is when this context has been saved with cm_el1_sysregs_context_save()
+ * or restored by this library, and the lower ELs haven't run since then.
+ * With CTX_LAZY_EL1_SYSREGS, the registers that already hold the value to
+ * restore are then left alone.
+ ******************************************************************************/
+void cm_el1_sysregs_context_restore_lazy(uint32_t security_state)
+{
+#if CTX_LAZY_EL1_SYSREGS
+	cpu_context_t *ctx, *live_ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx);
+
+	live_ctx = cm_get_context((security_state == SECURE) ?
+				  NON_SECURE : SECURE);
+	assert(live_ctx);
+
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_ENTER_EL1_CTX_RESTORE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
+	el1_sysregs_context_restore_lazy(get_sysregs_ctx(ctx),
+					 get_sysregs_ctx(live_ctx));
+
+#if IMAGE_BL31 && ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_ctx_svc,
+		RT_INSTR_EXIT_EL1_CTX_RESTORE,
+		PMF_NO_CACHE_MAINT);
+#endif
+
+	cm_el1_sysregs_context_restored(security_state);
+#else
+	cm_el1_sysregs_context_restore(security_state);
 #endif
 }
 
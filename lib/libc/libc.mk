@@ -4,15 +4,28 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 
+# With LIBC_WORD_MEM_OPS, AArch64 uses the assembly versions of the memory
+# functions, which access memory with LDP/STP. AArch32 uses the word-at-a-time
+# C versions.
+ifeq (${LIBC_WORD_MEM_OPS}-${ARCH},1-aarch64)
+LIBC_MEM_SRCS	:=	$(addprefix aarch64/,		\
+			memcmp.S			\
+			memcpy.S			\
+			memmove.S			\
+			memset.S)
+else
+LIBC_MEM_SRCS	:=	memcmp.c			\
+			memcpy.c			\
+			memmove.c			\
+			memset.c
+endif
+
 LIBC_SRCS	:=	$(addprefix lib/libc/,	\
 			abort.c				\
 			assert.c			\
 			exit.c				\
 			memchr.c			\
-			memcmp.c			\
-			memcpy.c			\
-			memmove.c			\
-			memset.c			\
+			${LIBC_MEM_SRCS}		\
 			printf.c			\
 			putchar.c			\
 			puts.c				\
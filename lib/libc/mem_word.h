@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MEM_WORD_H
+#define MEM_WORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Helpers for the word-at-a-time memory functions selected with
+ * LIBC_WORD_MEM_OPS. AArch64 builds use the assembly versions in aarch64/
+ * instead, so these are only built for AArch32, where a word is 32 bits and
+ * two consecutive accesses can be paired into LDRD/STRD or LDM/STM. The type
+ * may alias any object, as the buffers handled by memcpy() and friends can
+ * have any effective type.
+ */
+typedef unsigned long __attribute__((__may_alias__)) mem_word_t;
+
+#define MEM_WORD_SIZE		sizeof(mem_word_t)
+#define MEM_WORD_MASK		(MEM_WORD_SIZE - 1U)
+
+/*
+ * Word accesses are only used when both buffers share the same alignment
+ * relative to a word boundary: unaligned accesses are not allowed by
+ * -mstrict-align / -mno-unaligned-access, and may fault with the MMU off.
+ * Mismatched buffers are handled by the plain byte loops.
+ */
+static inline int mem_word_coaligned(const void *p1, const void *p2)
+{
+	return (((uintptr_t)p1 ^ (uintptr_t)p2) & MEM_WORD_MASK) == 0U;
+}
+
+static inline size_t mem_word_misalign(const void *p)
+{
+	return (size_t)((uintptr_t)p & MEM_WORD_MASK);
+}
+
+#endif /* MEM_WORD_H */
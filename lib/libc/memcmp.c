@@ -6,6 +6,10 @@
 
 #include <stddef.h>
 
+#if LIBC_WORD_MEM_OPS
+#include "mem_word.h"
+#endif
+
 int memcmp(const void *s1, const void *s2, size_t len)
 {
 	const unsigned char *s = s1;
@@ -13,6 +17,38 @@ int memcmp(const void *s1, const void *s2, size_t len)
 	unsigned char sc;
 	unsigned char dc;
 
+#if LIBC_WORD_MEM_OPS
+	if ((len >= (2U * MEM_WORD_SIZE)) && mem_word_coaligned(s, d)) {
+		const mem_word_t *ws;
+		const mem_word_t *wd;
+
+		while (mem_word_misalign(s) != 0U) {
+			sc = *s++;
+			dc = *d++;
+			if (sc - dc)
+				return (sc - dc);
+			len--;
+		}
+
+		ws = (const mem_word_t *)s;
+		wd = (const mem_word_t *)d;
+
+		/*
+		 * Skip over the words that match. The first mismatching word,
+		 * if any, is left to the byte loop below, which finds the
+		 * differing byte and so the sign of the result.
+		 */
+		while ((len >= MEM_WORD_SIZE) && (*ws == *wd)) {
+			ws++;
+			wd++;
+			len -= MEM_WORD_SIZE;
+		}
+
+		s = (const unsigned char *)ws;
+		d = (const unsigned char *)wd;
+	}
+#endif
+
 	while (len--) {
 		sc = *s++;
 		dc = *d++;
@@ -6,11 +6,51 @@
 
 #include <stddef.h>
 
+#if LIBC_WORD_MEM_OPS
+#include "mem_word.h"
+#endif
+
 void *memcpy(void *dst, const void *src, size_t len)
 {
 	const char *s = src;
 	char *d = dst;
 
+#if LIBC_WORD_MEM_OPS
+	if ((len >= (2U * MEM_WORD_SIZE)) && mem_word_coaligned(d, s)) {
+		const mem_word_t *ws;
+		mem_word_t *wd;
+
+		/* Copy the head bytes up to the first word boundary */
+		while (mem_word_misalign(d) != 0U) {
+			*d++ = *s++;
+			len--;
+		}
+
+		ws = (const mem_word_t *)s;
+		wd = (mem_word_t *)d;
+
+		/* Copy two words per iteration so that accesses are paired */
+		while (len >= (2U * MEM_WORD_SIZE)) {
+			mem_word_t w0 = ws[0];
+			mem_word_t w1 = ws[1];
+
+			wd[0] = w0;
+			wd[1] = w1;
+			ws += 2;
+			wd += 2;
+			len -= 2U * MEM_WORD_SIZE;
+		}
+
+		if (len >= MEM_WORD_SIZE) {
+			*wd++ = *ws++;
+			len -= MEM_WORD_SIZE;
+		}
+
+		s = (const char *)ws;
+		d = (char *)wd;
+	}
+#endif
+
 	while (len--)
 		*d++ = *s++;
 
@@ -6,6 +6,10 @@
 
 #include <string.h>
 
+#if LIBC_WORD_MEM_OPS
+#include "mem_word.h"
+#endif
+
 void *memmove(void *dst, const void *src, size_t len)
 {
 	/*
@@ -24,6 +28,32 @@ void *memmove(void *dst, const void *src, size_t len)
 		const char *end = dst;
 		const char *s = (const char *)src + len;
 		char *d = (char *)dst + len;
+#if LIBC_WORD_MEM_OPS
+		/*
+		 * The source is below the destination, so copying whole words
+		 * from the top down never overwrites source data not yet read.
+		 */
+		if ((len >= (2U * MEM_WORD_SIZE)) && mem_word_coaligned(d, s)) {
+			const mem_word_t *ws;
+			mem_word_t *wd;
+
+			while (mem_word_misalign(d) != 0U) {
+				*--d = *--s;
+				len--;
+			}
+
+			ws = (const mem_word_t *)s;
+			wd = (mem_word_t *)d;
+
+			while (len >= MEM_WORD_SIZE) {
+				*--wd = *--ws;
+				len -= MEM_WORD_SIZE;
+			}
+
+			s = (const char *)ws;
+			d = (char *)wd;
+		}
+#endif
 		while (d != end)
 			*--d = *--s;
 	}
@@ -6,10 +6,43 @@
 
 #include <stddef.h>
 
+#if LIBC_WORD_MEM_OPS
+#include "mem_word.h"
+#endif
+
 void *memset(void *dst, int val, size_t count)
 {
 	char *ptr = dst;
 
+#if LIBC_WORD_MEM_OPS
+	if (count >= (2U * MEM_WORD_SIZE)) {
+		/* Replicate the byte value across a whole word */
+		mem_word_t pattern = (unsigned char)val * (~0UL / 0xffUL);
+		mem_word_t *wptr;
+
+		while (mem_word_misalign(ptr) != 0U) {
+			*ptr++ = val;
+			count--;
+		}
+
+		wptr = (mem_word_t *)ptr;
+
+		while (count >= (2U * MEM_WORD_SIZE)) {
+			wptr[0] = pattern;
+			wptr[1] = pattern;
+			wptr += 2;
+			count -= 2U * MEM_WORD_SIZE;
+		}
+
+		if (count >= MEM_WORD_SIZE) {
+			*wptr++ = pattern;
+			count -= MEM_WORD_SIZE;
+		}
+
+		ptr = (char *)wptr;
+	}
+#endif
+
 	while (count--)
 		*ptr++ = val;
 
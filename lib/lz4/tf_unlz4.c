@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <debug.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <tf_unlz4.h>
+
+/*
+ * LZ4 decompressor for the frame format produced by the lz4 command line tool
+ * and for the legacy format ("lz4 -l") used by Linux kernel images.
+ *
+ * Checksums in the frame are skipped rather than verified: the integrity of
+ * the compressed image is already covered by Trusted Board Boot if enabled,
+ * and the decoder never reads or writes outside of the given buffers.
+ */
+
+#define LZ4_FRAME_MAGIC			0x184D2204U
+#define LZ4_LEGACY_MAGIC		0x184C2102U
+#define LZ4_SKIPPABLE_MAGIC		0x184D2A50U
+#define LZ4_SKIPPABLE_MAGIC_MASK	0xFFFFFFF0U
+
+/* Frame descriptor FLG byte */
+#define LZ4_FLG_VERSION_SHIFT		6
+#define LZ4_FLG_VERSION_MASK		0x3U
+#define LZ4_FLG_VERSION			1U
+#define LZ4_FLG_BLOCK_CHECKSUM		(1U << 4)
+#define LZ4_FLG_CONTENT_SIZE		(1U << 3)
+#define LZ4_FLG_CONTENT_CHECKSUM	(1U << 2)
+#define LZ4_FLG_DICT_ID			(1U << 0)
+
+/* Block size field: the top bit flags a block stored uncompressed */
+#define LZ4_BLOCK_UNCOMPRESSED		(1U << 31)
+#define LZ4_BLOCK_SIZE_MASK		(~LZ4_BLOCK_UNCOMPRESSED)
+
+#define LZ4_CHECKSUM_SIZE		4U
+#define LZ4_MIN_MATCH			4U
+
+static uint32_t read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * Read an LZ4 length extension: a run of bytes that are added to the length
+ * until a byte other than 255 is found.
+ */
+static int read_length(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*ip >= iend)
+			return -EIO;
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 255U);
+
+	return 0;
+}
+
+/*
+ * Decompress one LZ4 block. Matches may refer to data decompressed from
+ * previous blocks of the same frame, which is found right before `*op` since
+ * the output is contiguous.
+ */
+static int decompress_block(const uint8_t *ip, size_t in_len,
+			    uint8_t **op, uint8_t *oend, const uint8_t *ostart)
+{
+	const uint8_t *iend = ip + in_len;
+	uint8_t *o = *op;
+	size_t len, offset;
+	unsigned int token;
+
+	while (ip < iend) {
+		token = *ip++;
+
+		/* Literals */
+		len = token >> 4;
+		if ((len == 15U) && (read_length(&ip, iend, &len) != 0))
+			return -EIO;
+
+		if ((len > (size_t)(iend - ip)) || (len > (size_t)(oend - o)))
+			return -EIO;
+
+		memcpy(o, ip, len);
+		ip += len;
+		o += len;
+
+		/* The last sequence of a block has no match */
+		if (ip == iend)
+			break;
+
+		/* Match */
+		if ((iend - ip) < 2)
+			return -EIO;
+		offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+
+		if ((offset == 0U) || (offset > (size_t)(o - ostart)))
+			return -EIO;
+
+		len = token & 0xfU;
+		if ((len == 15U) && (read_length(&ip, iend, &len) != 0))
+			return -EIO;
+		len += LZ4_MIN_MATCH;
+
+		if (len > (size_t)(oend - o))
+			return -EIO;
+
+		if (offset >= len) {
+			memcpy(o, o - offset, len);
+			o += len;
+		} else {
+			/* Overlapping match, repeating the last offset bytes */
+			const uint8_t *m = o - offset;
+
+			while (len-- != 0U)
+				*o++ = *m++;
+		}
+	}
+
+	*op = o;
+
+	return 0;
+}
+
+static int decompress_frame(const uint8_t **ipp, const uint8_t *iend,
+			    uint8_t **op, uint8_t *oend)
+{
+	const uint8_t *ip = *ipp;
+	const uint8_t *ostart = *op;
+	uint32_t block_size;
+	unsigned int flg;
+	size_t skip;
+	int ret;
+
+	/* FLG, BD and header checksum, plus the optional fields */
+	if ((iend - ip) < 3)
+		return -EIO;
+
+	flg = ip[0];
+	if (((flg >> LZ4_FLG_VERSION_SHIFT) & LZ4_FLG_VERSION_MASK) !=
+	    LZ4_FLG_VERSION) {
+		ERROR("lz4: unsupported frame version\n");
+		return -EIO;
+	}
+
+	if ((flg & LZ4_FLG_DICT_ID) != 0U) {
+		ERROR("lz4: dictionaries are not supported\n");
+		return -EIO;
+	}
+
+	skip = 3U;
+	if ((flg & LZ4_FLG_CONTENT_SIZE) != 0U)
+		skip += 8U;
+	if ((size_t)(iend - ip) < skip)
+		return -EIO;
+	ip += skip;
+
+	for (;;) {
+		if ((iend - ip) < 4)
+			return -EIO;
+		block_size = read_le32(ip);
+		ip += 4;
+
+		/* End mark */
+		if (block_size == 0U)
+			break;
+
+		if ((block_size & LZ4_BLOCK_SIZE_MASK) > (size_t)(iend - ip))
+			return -EIO;
+
+		if ((block_size & LZ4_BLOCK_UNCOMPRESSED) != 0U) {
+			block_size &= LZ4_BLOCK_SIZE_MASK;
+			if (block_size > (size_t)(oend - *op))
+				return -EIO;
+			memcpy(*op, ip, block_size);
+			*op += block_size;
+		} else {
+			ret = decompress_block(ip, block_size, op, oend,
+					       ostart);
+			if (ret != 0)
+				return ret;
+		}
+		ip += block_size;
+
+		if ((flg & LZ4_FLG_BLOCK_CHECKSUM) != 0U)
+			ip += LZ4_CHECKSUM_SIZE;
+	}
+
+	if ((flg & LZ4_FLG_CONTENT_CHECKSUM) != 0U)
+		ip += LZ4_CHECKSUM_SIZE;
+
+	if (ip > iend)
+		return -EIO;
+
+	*ipp = ip;
+
+	return 0;
+}
+
+static int decompress_legacy(const uint8_t **ipp, const uint8_t *iend,
+			     uint8_t **op, uint8_t *oend)
+{
+	const uint8_t *ip = *ipp;
+	uint32_t block_size;
+	int ret;
+
+	/*
+	 * Legacy blocks are independent and always compressed. The stream ends
+	 * with the input, or with the magic number of a following frame.
+	 */
+	while ((iend - ip) >= 4) {
+		block_size = read_le32(ip);
+		if ((block_size == LZ4_FRAME_MAGIC) ||
+		    (block_size == LZ4_LEGACY_MAGIC))
+			break;
+		ip += 4;
+
+		/*
+		 * Linux kernel images built by kbuild end with the size of the
+		 * decompressed data on 4 bytes. A block cannot be empty, so 4
+		 * bytes left at the end of the input are that size.
+		 */
+		if (ip == iend)
+			break;
+
+		if (block_size > (size_t)(iend - ip))
+			return -EIO;
+
+		ret = decompress_block(ip, block_size, op, oend, *op);
+		if (ret != 0)
+			return ret;
+		ip += block_size;
+	}
+
+	*ipp = ip;
+
+	return 0;
+}
+
+/*
+ * unlz4 - decompress LZ4 data
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused, LZ4 decompresses in place in the output)
+ * @work_len: length of workspace
+ */
+int unlz4(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+	  size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	const uint8_t *ip = (const uint8_t *)*in_buf;
+	const uint8_t *iend = ip + in_len;
+	uint8_t *op = (uint8_t *)*out_buf;
+	uint8_t *oend = op + out_len;
+	uint32_t magic;
+	int ret = 0;
+
+	/* Concatenated frames are decompressed one after the other */
+	while ((iend - ip) >= 4) {
+		magic = read_le32(ip);
+		ip += 4;
+
+		if (magic == LZ4_FRAME_MAGIC) {
+			ret = decompress_frame(&ip, iend, &op, oend);
+		} else if (magic == LZ4_LEGACY_MAGIC) {
+			ret = decompress_legacy(&ip, iend, &op, oend);
+		} else if ((magic & LZ4_SKIPPABLE_MAGIC_MASK) ==
+			   LZ4_SKIPPABLE_MAGIC) {
+			if (((iend - ip) < 4) ||
+			    (read_le32(ip) > (size_t)(iend - ip - 4))) {
+				ret = -EIO;
+			} else {
+				ip += 4U + read_le32(ip);
+			}
+		} else {
+			ERROR("lz4: bad magic number 0x%x\n", magic);
+			ret = -EIO;
+		}
+
+		if (ret != 0) {
+			ERROR("lz4: decompression failed (ret = %d)\n", ret);
+			break;
+		}
+	}
+
+	VERBOSE("lz4: %lu byte input\n",
+		(unsigned long)(ip - (const uint8_t *)*in_buf));
+	VERBOSE("lz4: %lu byte output\n",
+		(unsigned long)(op - (uint8_t *)*out_buf));
+
+	*in_buf = (uintptr_t)ip;
+	*out_buf = (uintptr_t)op;
+
+	return ret;
+}
@@ -60,6 +60,24 @@ DEFINE_PSCI_LOCK(psci_locks[PSCI_NUM_NON_CPU_PWR_DOMAINS]);
 
 cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 
+#if PSCI_LOCKLESS_COORDINATION
+/*
+ * Number of running children of each non CPU power domain. At the lowest
+ * level above the CPUs, these are the CPUs that are running and have not
+ * started coordination to suspend or turn off. At the higher levels, these
+ * are the child power domains whose count is not 0. A CPU that suspends while
+ * other CPUs of its parent power domain are running thus only changes the
+ * count of that power domain, in a single atomic operation. The counts are
+ * updated without holding the locks, so each of them is kept in its own cache
+ * line.
+ */
+typedef struct psci_pd_active {
+	unsigned int running;
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_pd_active_t;
+
+static psci_pd_active_t psci_pd_active[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+#endif
+
 /*******************************************************************************
  * Pointer to functions exported by the platform to complete power mgmt. ops
  ******************************************************************************/
@@ -364,6 +382,46 @@ void psci_get_parent_pwr_domain_nodes(int cpu_idx,
 	}
 }
 
+#if PSCI_LOCKLESS_COORDINATION
+/******************************************************************************
+ * These functions count the current CPU as running in its ancestor power
+ * domains, and stop counting it. A count that leaves or drops to 0 changes the
+ * count of the next level, up to the highest power level, whatever level the
+ * caller holds the locks up to. A CPU only requests the RUN state for the
+ * levels above the ones it locks, so the CPU which coordinates them never
+ * powers them down on its account.
+ *
+ * psci_pd_active_dec() returns the highest power level whose power domain has
+ * no running child left, or PSCI_CPU_PWR_LVL if the parent of the CPU still
+ * has running CPUs. The levels above it stay in RUN state.
+ *****************************************************************************/
+static void psci_pd_active_inc(unsigned int cpu_idx)
+{
+	unsigned int lvl, parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		if (psci_atomic_add(&psci_pd_active[parent_idx].running, 1)
+		    != 1U)
+			break;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+}
+
+static unsigned int psci_pd_active_dec(unsigned int cpu_idx)
+{
+	unsigned int lvl, parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		if (psci_atomic_add(&psci_pd_active[parent_idx].running, -1)
+		    != 0U)
+			break;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	return lvl - 1U;
+}
+#endif
+
 /******************************************************************************
  * This function is invoked post CPU power up and initialization. It sets the
  * affinity info state, target power state and requested power state for the
@@ -384,6 +442,10 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
+#if PSCI_LOCKLESS_COORDINATION
+	psci_pd_active_inc(cpu_idx);
+#endif
+
 	/* Set the affinity info state to ON */
 	psci_set_aff_info_state(AFF_STATE_ON);
 
@@ -418,10 +480,22 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	int start_idx;
 	unsigned int ncpus;
 	plat_local_state_t target_state, *req_states;
+#if PSCI_LOCKLESS_COORDINATION
+	unsigned int idle_lvl;
+#endif
 
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
+#if PSCI_LOCKLESS_COORDINATION
+	/*
+	 * The power domains that still have running children stay in RUN
+	 * state, even if those are about to suspend and have already updated
+	 * their requested power states.
+	 */
+	idle_lvl = psci_pd_active_dec(cpu_idx);
+#endif
+
 	/* For level 0, the requested state will be equivalent
 	   to target state */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
@@ -430,6 +504,14 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 		psci_set_req_local_pwr_state(lvl, cpu_idx,
 					     state_info->pwr_domain_state[lvl]);
 
+#if PSCI_LOCKLESS_COORDINATION
+		if (lvl > idle_lvl) {
+			state_info->pwr_domain_state[lvl] =
+				PSCI_LOCAL_STATE_RUN;
+			break;
+		}
+#endif
+
 		/* Get the requested power states for this power level */
 		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
 		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
@@ -469,6 +551,57 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
 }
 
+#if PSCI_LOCKLESS_COORDINATION
+/******************************************************************************
+ * This function is the lock-free counterpart of psci_do_state_coordination(),
+ * for when the current CPU is not the last one of its cluster to request a
+ * low power state. The cluster and its ancestors then stay in RUN state
+ * whatever this CPU requests, so no coordination is needed: the requested
+ * states are recorded, the target state of every level above the CPU is set
+ * to RUN in 'state_info', and 1 is returned. Otherwise 0 is returned, and the
+ * caller must take the locks and call psci_do_state_coordination().
+ *
+ * The requested states are recorded before the count of running CPUs of the
+ * cluster is decremented, so that the CPU which does the coordination once
+ * the count reaches 0 sees them. The states recorded by a CPU that turns out
+ * to be the last one are ignored until it decrements the count itself. The
+ * count of the cluster is the only one to change: the counts of the higher
+ * levels count running child power domains, and the cluster keeps running.
+ *****************************************************************************/
+unsigned int psci_lockless_state_coordination(unsigned int end_pwrlvl,
+					      psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx, cpu_idx = plat_my_core_pos();
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+
+	if (end_pwrlvl == PSCI_CPU_PWR_LVL)
+		return 0U;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++)
+		psci_set_req_local_pwr_state(lvl, cpu_idx,
+					     state_info->pwr_domain_state[lvl]);
+
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	if (psci_atomic_dec_unless_last(&psci_pd_active[parent_idx].running)
+	    == 0U)
+		return 0U;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++)
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+
+	/*
+	 * Only the state of the CPU changes. The states of the other power
+	 * domain nodes are RUN, and are left to the CPUs holding the locks.
+	 */
+	psci_set_cpu_local_state(
+			state_info->pwr_domain_state[PSCI_CPU_PWR_LVL]);
+	psci_flush_cpu_data(psci_svc_cpu_data.local_state);
+
+	return 1U;
+}
+#endif
+
 /******************************************************************************
  * This function validates a suspend request by making sure that if a standby
  * state is requested then no power level is turned off and the highest power
@@ -12,7 +12,9 @@
 #include <platform.h>
 #include <pmf.h>
 #include <runtime_instr.h>
+#include <runtime_svc.h>
 #include <smccc.h>
+#include <smccc_helpers.h>
 #include <string.h>
 #include "psci_private.h"
 
@@ -44,6 +46,61 @@ int psci_cpu_on(u_register_t target_cpu,
 	return psci_cpu_on_start(target_cpu, &ep);
 }
 
+#ifndef AARCH32
+/*******************************************************************************
+ * Handler of PSCI_CPU_ON_MULTI_64, which powers on several CPUs with the same
+ * entry point in a single call, so that the platform requests to power them on
+ * can be issued together:
+ *   x1: entry point address
+ *   x2: context id
+ *   x3: base mpidr, whose affinity field at level x5 must be 0
+ *   x4: bitmap of the CPUs to power on, as psci_cpu_on_multi_mpidr() defines
+ *   x5: affinity level selected by the bitmap, up to 2
+ * Returns the PSCI error code in x0, and the bitmap of the CPUs being powered
+ * on in x1. All the CPUs must exist, otherwise none is powered on.
+ ******************************************************************************/
+uintptr_t psci_cpu_on_multi_smc_handler(uint32_t smc_fid,
+					u_register_t x1,
+					u_register_t x2,
+					u_register_t x3,
+					u_register_t x4,
+					void *cookie,
+					void *handle,
+					u_register_t flags)
+{
+	entry_point_info_t ep;
+	unsigned int aff_lvl, n;
+	uint64_t on;
+	int rc;
+
+	if ((smc_fid != PSCI_CPU_ON_MULTI_64) || is_caller_secure(flags))
+		SMC_RET1(handle, SMC_UNK);
+
+	aff_lvl = (unsigned int)SMC_GET_GP(handle, CTX_GPREG_X5);
+	if ((aff_lvl > MPIDR_AFFLVL2) || (x4 == 0U) ||
+	    (((x3 >> (aff_lvl * MPIDR_AFFINITY_BITS)) &
+	      MPIDR_AFFLVL_MASK) != 0U))
+		SMC_RET2(handle, PSCI_E_INVALID_PARAMS, 0);
+
+	for (n = 0U; n < 64U; n++) {
+		if ((x4 & (1ULL << n)) == 0U)
+			continue;
+
+		rc = psci_validate_mpidr(psci_cpu_on_multi_mpidr(x3, aff_lvl, n));
+		if (rc != PSCI_E_SUCCESS)
+			SMC_RET2(handle, PSCI_E_INVALID_PARAMS, 0);
+	}
+
+	rc = psci_validate_entry_point(&ep, x1, x2);
+	if (rc != PSCI_E_SUCCESS)
+		SMC_RET2(handle, rc, 0);
+
+	on = psci_cpu_on_multi_start(x3, aff_lvl, x4, &ep, &rc);
+
+	SMC_RET2(handle, rc, on);
+}
+#endif
+
 unsigned int psci_version(void)
 {
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
@@ -45,32 +45,14 @@ static int cpu_on_validate_state(aff_info_state_t aff_state)
 }
 
 /*******************************************************************************
- * Generic handler which is called to physically power on a cpu identified by
- * its mpidr. It performs the generic, architectural, platform setup and state
- * management to power on the target cpu e.g. it will ensure that
- * enough information is stashed for it to resume execution in the non-secure
- * security state.
- *
- * The state of all the relevant power domains are changed after calling the
- * platform handler as it can return error.
+ * This function checks that a cpu which has been requested to be turned on is
+ * OFF, and marks it as being turned on. On success, it returns with the lock
+ * of the target cpu held, which psci_cpu_on_complete() releases.
  ******************************************************************************/
-int psci_cpu_on_start(u_register_t target_cpu,
-		      const entry_point_info_t *ep)
+static int psci_cpu_on_prepare(u_register_t target_cpu, int target_idx)
 {
 	int rc;
 	aff_info_state_t target_aff_state;
-	int target_idx = plat_core_pos_by_mpidr(target_cpu);
-
-	/* Calling function must supply valid input arguments */
-	assert(target_idx >= 0);
-	assert(ep != NULL);
-
-	/*
-	 * This function must only be called on platforms where the
-	 * CPU_ON platform hooks have been implemented.
-	 */
-	assert((psci_plat_pm_ops->pwr_domain_on != NULL) &&
-	       (psci_plat_pm_ops->pwr_domain_on_finish != NULL));
 
 	/* Protect against multiple CPUs trying to turn ON the same target CPU */
 	psci_spin_lock_cpu(target_idx);
@@ -94,8 +76,10 @@ int psci_cpu_on_start(u_register_t target_cpu,
 	flush_cpu_data_by_index((unsigned int)target_idx,
 				psci_svc_cpu_data.aff_info_state);
 	rc = cpu_on_validate_state(psci_get_aff_info_state_by_idx(target_idx));
-	if (rc != PSCI_E_SUCCESS)
-		goto exit;
+	if (rc != PSCI_E_SUCCESS) {
+		psci_spin_unlock_cpu(target_idx);
+		return rc;
+	}
 
 	/*
 	 * Call the cpu on handler registered by the Secure Payload Dispatcher
@@ -131,17 +115,16 @@ int psci_cpu_on_start(u_register_t target_cpu,
 		       AFF_STATE_ON_PENDING);
 	}
 
-	/*
-	 * Perform generic, architecture and platform specific handling.
-	 */
-	/*
-	 * Plat. management: Give the platform the current state
-	 * of the target cpu to allow it to perform the necessary
-	 * steps to power on.
-	 */
-	rc = psci_plat_pm_ops->pwr_domain_on(target_cpu);
-	assert((rc == PSCI_E_SUCCESS) || (rc == PSCI_E_INTERN_FAIL));
+	return PSCI_E_SUCCESS;
+}
 
+/*******************************************************************************
+ * This function completes a power on request once the platform has handled it
+ * with result 'rc', and releases the lock of the target cpu.
+ ******************************************************************************/
+static void psci_cpu_on_complete(int target_idx, const entry_point_info_t *ep,
+				 int rc)
+{
 	if (rc == PSCI_E_SUCCESS)
 		/* Store the re-entry information for the non-secure world. */
 		cm_init_context_by_index((unsigned int)target_idx, ep);
@@ -152,11 +135,147 @@ int psci_cpu_on_start(u_register_t target_cpu,
 					psci_svc_cpu_data.aff_info_state);
 	}
 
-exit:
 	psci_spin_unlock_cpu(target_idx);
+}
+
+/*******************************************************************************
+ * Generic handler which is called to physically power on a cpu identified by
+ * its mpidr. It performs the generic, architectural, platform setup and state
+ * management to power on the target cpu e.g. it will ensure that
+ * enough information is stashed for it to resume execution in the non-secure
+ * security state.
+ *
+ * The state of all the relevant power domains are changed after calling the
+ * platform handler as it can return error.
+ ******************************************************************************/
+int psci_cpu_on_start(u_register_t target_cpu,
+		      const entry_point_info_t *ep)
+{
+	int rc;
+	int target_idx = plat_core_pos_by_mpidr(target_cpu);
+
+	/* Calling function must supply valid input arguments */
+	assert(target_idx >= 0);
+	assert(ep != NULL);
+
+	/*
+	 * This function must only be called on platforms where the
+	 * CPU_ON platform hooks have been implemented.
+	 */
+	assert((psci_plat_pm_ops->pwr_domain_on != NULL) &&
+	       (psci_plat_pm_ops->pwr_domain_on_finish != NULL));
+
+	rc = psci_cpu_on_prepare(target_cpu, target_idx);
+	if (rc != PSCI_E_SUCCESS)
+		return rc;
+
+	/*
+	 * Perform generic, architecture and platform specific handling.
+	 */
+	/*
+	 * Plat. management: Give the platform the current state
+	 * of the target cpu to allow it to perform the necessary
+	 * steps to power on.
+	 */
+	rc = psci_plat_pm_ops->pwr_domain_on(target_cpu);
+	assert((rc == PSCI_E_SUCCESS) || (rc == PSCI_E_INTERN_FAIL));
+
+	psci_cpu_on_complete(target_idx, ep, rc);
+
 	return rc;
 }
 
+/*******************************************************************************
+ * Generic handler which is called to power on the cpus of the 'targets'
+ * bitmap with the same entry point, as psci_cpu_on_start() does for each of
+ * them. Bit N of 'targets' stands for the cpu whose mpidr is returned by
+ * psci_cpu_on_multi_mpidr(base_mpidr, aff_lvl, N), which must exist.
+ *
+ * The locks of the target cpus are taken in the order of their mpidrs, and
+ * held until all of them have been handled. If the platform implements
+ * pwr_domain_on_multi(), it is given all the cpus to power on at once so that
+ * it can batch its requests to the power controller.
+ *
+ * Returns the bitmap of the cpus being turned on. 'rc' is set to the error of
+ * the first cpu that could not be turned on, or PSCI_E_SUCCESS.
+ ******************************************************************************/
+uint64_t psci_cpu_on_multi_start(u_register_t base_mpidr, unsigned int aff_lvl,
+				 uint64_t targets,
+				 const entry_point_info_t *ep, int *rc)
+{
+	uint64_t pending = 0ULL, on = 0ULL, bit;
+	u_register_t target_cpu;
+	unsigned int n;
+	int ret;
+
+	assert(ep != NULL);
+	assert(rc != NULL);
+	assert((psci_plat_pm_ops->pwr_domain_on != NULL) &&
+	       (psci_plat_pm_ops->pwr_domain_on_finish != NULL));
+
+	*rc = PSCI_E_SUCCESS;
+
+	for (n = 0U; n < 64U; n++) {
+		bit = 1ULL << n;
+		if ((targets & bit) == 0ULL)
+			continue;
+
+		target_cpu = psci_cpu_on_multi_mpidr(base_mpidr, aff_lvl, n);
+		assert(plat_core_pos_by_mpidr(target_cpu) >= 0);
+
+		ret = psci_cpu_on_prepare(target_cpu,
+					  plat_core_pos_by_mpidr(target_cpu));
+		if (ret == PSCI_E_SUCCESS)
+			pending |= bit;
+		else if (*rc == PSCI_E_SUCCESS)
+			*rc = ret;
+	}
+
+	if (pending == 0ULL)
+		return 0ULL;
+
+	/*
+	 * Plat. management: Let the platform power on all the target cpus at
+	 * once if it can, otherwise one at a time.
+	 */
+	if (psci_plat_pm_ops->pwr_domain_on_multi != NULL) {
+		on = psci_plat_pm_ops->pwr_domain_on_multi(base_mpidr, aff_lvl,
+							   pending);
+		assert((on & ~pending) == 0ULL);
+	} else {
+		for (n = 0U; n < 64U; n++) {
+			bit = 1ULL << n;
+			if ((pending & bit) == 0ULL)
+				continue;
+
+			target_cpu = psci_cpu_on_multi_mpidr(base_mpidr,
+							     aff_lvl, n);
+			ret = psci_plat_pm_ops->pwr_domain_on(target_cpu);
+			assert((ret == PSCI_E_SUCCESS) ||
+			       (ret == PSCI_E_INTERN_FAIL));
+			if (ret == PSCI_E_SUCCESS)
+				on |= bit;
+		}
+	}
+
+	for (n = 0U; n < 64U; n++) {
+		bit = 1ULL << n;
+		if ((pending & bit) == 0ULL)
+			continue;
+
+		ret = ((on & bit) != 0ULL) ? PSCI_E_SUCCESS :
+					      PSCI_E_INTERN_FAIL;
+		if ((ret != PSCI_E_SUCCESS) && (*rc == PSCI_E_SUCCESS))
+			*rc = ret;
+
+		target_cpu = psci_cpu_on_multi_mpidr(base_mpidr, aff_lvl, n);
+		psci_cpu_on_complete(plat_core_pos_by_mpidr(target_cpu), ep,
+				     ret);
+	}
+
+	return on;
+}
+
 /*******************************************************************************
  * The following function finish an earlier power on request. They
  * are called by the common finisher routine in psci_common.c. The `state_info`
@@ -15,6 +15,7 @@
 #include <psci.h>
 #include <spinlock.h>
 #include <stdbool.h>
+#include <ticket_lock.h>
 
 /*
  * The PSCI capability which are provided by the generic code but does not
@@ -159,9 +160,18 @@ typedef struct cpu_pwr_domain_node {
 #if HW_ASSISTED_COHERENCY
 /*
  * On systems where participant CPUs are cache-coherent, we can use spinlocks
- * instead of bakery locks.
+ * instead of bakery locks. Ticket locks may be chosen instead, so that the
+ * locks are granted in order when many CPUs contend for them.
  */
+#if USE_TICKET_LOCKS
+#define DEFINE_PSCI_LOCK(_name)		ticket_lock_t _name
+#define psci_lock_acquire(_lock)	ticket_lock_get(_lock)
+#define psci_lock_drop(_lock)		ticket_lock_release(_lock)
+#else
 #define DEFINE_PSCI_LOCK(_name)		spinlock_t _name
+#define psci_lock_acquire(_lock)	spin_lock(_lock)
+#define psci_lock_drop(_lock)		spin_unlock(_lock)
+#endif
 #define DECLARE_PSCI_LOCK(_name)	extern DEFINE_PSCI_LOCK(_name)
 
 /* One lock is required per non-CPU power domain node */
@@ -188,12 +198,12 @@ static inline void psci_dsbish(void)
 
 static inline void psci_lock_get(non_cpu_pd_node_t *non_cpu_pd_node)
 {
-	spin_lock(&psci_locks[non_cpu_pd_node->lock_index]);
+	psci_lock_acquire(&psci_locks[non_cpu_pd_node->lock_index]);
 }
 
 static inline void psci_lock_release(non_cpu_pd_node_t *non_cpu_pd_node)
 {
-	spin_unlock(&psci_locks[non_cpu_pd_node->lock_index]);
+	psci_lock_drop(&psci_locks[non_cpu_pd_node->lock_index]);
 }
 
 #else /* if HW_ASSISTED_COHERENCY == 0 */
@@ -273,6 +283,10 @@ void psci_get_parent_pwr_domain_nodes(int cpu_idx,
 				      unsigned int *node_index);
 void psci_do_state_coordination(unsigned int end_pwrlvl,
 				psci_power_state_t *state_info);
+#if PSCI_LOCKLESS_COORDINATION
+unsigned int psci_lockless_state_coordination(unsigned int end_pwrlvl,
+					      psci_power_state_t *state_info);
+#endif
 void psci_acquire_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx);
 void psci_release_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx);
 int psci_validate_suspend_req(const psci_power_state_t *state_info,
@@ -295,6 +309,9 @@ void prepare_cpu_pwr_dwn(unsigned int power_level);
 /* Private exported functions from psci_on.c */
 int psci_cpu_on_start(u_register_t target_cpu,
 		      const entry_point_info_t *ep);
+uint64_t psci_cpu_on_multi_start(u_register_t base_mpidr, unsigned int aff_lvl,
+				 uint64_t targets,
+				 const entry_point_info_t *ep, int *rc);
 
 void psci_cpu_on_finish(int cpu_idx, const psci_power_state_t *state_info);
 
@@ -312,6 +329,10 @@ void psci_cpu_suspend_finish(int cpu_idx, const psci_power_state_t *state_info);
 /* Private exported functions from psci_helpers.S */
 void psci_do_pwrdown_cache_maintenance(unsigned int pwr_level);
 void psci_do_pwrup_cache_maintenance(void);
+#if PSCI_LOCKLESS_COORDINATION
+unsigned int psci_atomic_add(unsigned int *count, int val);
+unsigned int psci_atomic_dec_unless_last(unsigned int *count);
+#endif
 
 /* Private exported functions from psci_system_off.c */
 void __dead2 psci_system_off(void);
@@ -6,8 +6,15 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <errno.h>
 #include <platform.h>
 #include <platform_def.h>
+#include <pmf.h>
+#include <psci_stat_hist.h>
+#include <runtime_instr.h>
+#include <runtime_svc.h>
+#include <smccc_helpers.h>
+#include <utils.h>
 #include "psci_private.h"
 
 #ifndef PLAT_MAX_PWR_LVL_STATES
@@ -36,6 +43,42 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+#if ENABLE_PSCI_STAT_HIST
+/*
+ * Histograms of the residency of each CPU in its local states, and of the
+ * latency of the CPU_SUSPEND or CPU_OFF calls to enter and exit them. Like
+ * psci_cpu_stat, the histograms of a CPU are only written by this CPU, so
+ * they are updated without the locks.
+ */
+typedef struct psci_stat_hist {
+	uint32_t hist[PLAT_MAX_PWR_LVL_STATES][PSCI_STAT_HIST_TYPES]
+		     [PSCI_STAT_HIST_BUCKETS];
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	/*
+	 * Index plus one of the state exited, or 0 once the latencies are
+	 * accounted for.
+	 */
+	int exit_stat_idx;
+#endif
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_stat_hist_t;
+
+static psci_stat_hist_t psci_cpu_stat_hist[PLATFORM_CORE_COUNT];
+
+static void psci_stat_hist_add(unsigned int cpu_idx, int stat_idx,
+			       unsigned int type, unsigned long long val)
+{
+	unsigned int bucket = 0U;
+
+	if (val != 0ULL) {
+		bucket = 64U - (unsigned int)__builtin_clzll(val);
+		if (bucket >= PSCI_STAT_HIST_BUCKETS)
+			bucket = PSCI_STAT_HIST_BUCKETS - 1U;
+	}
+
+	psci_cpu_stat_hist[cpu_idx].hist[stat_idx][type][bucket]++;
+}
+#endif
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -127,6 +170,15 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
 	psci_cpu_stat[cpu_idx][stat_idx].count++;
 
+#if ENABLE_PSCI_STAT_HIST
+	psci_stat_hist_add(cpu_idx, stat_idx, PSCI_STAT_HIST_RESIDENCY,
+			   residency);
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	/* The latencies are known once the PSCI call returns */
+	psci_cpu_stat_hist[cpu_idx].exit_stat_idx = stat_idx + 1;
+#endif
+#endif
+
 	/*
 	 * Check what power domains above CPU were off
 	 * prior to this CPU powering on.
@@ -245,3 +297,126 @@ u_register_t psci_stat_count(u_register_t target_cpu,
 	else
 		return 0;
 }
+
+#if ENABLE_PSCI_STAT_HIST
+#if ENABLE_RUNTIME_INSTRUMENTATION
+static unsigned long long ticks_to_ns(unsigned long long ticks)
+{
+	unsigned long long freq = plat_get_syscnt_freq2();
+
+	return ((ticks / freq) * 1000000000ULL) +
+	       (((ticks % freq) * 1000000000ULL) / freq);
+}
+
+static void psci_stat_hist_add_latency(unsigned int cpu_idx, int stat_idx,
+				       unsigned int type,
+				       unsigned int start_tid,
+				       unsigned int end_tid)
+{
+	unsigned long long start, end;
+
+	PMF_GET_TIMESTAMP_BY_INDEX(rt_instr_svc, start_tid, cpu_idx,
+				   PMF_NO_CACHE_MAINT, start);
+	PMF_GET_TIMESTAMP_BY_INDEX(rt_instr_svc, end_tid, cpu_idx,
+				   PMF_NO_CACHE_MAINT, end);
+
+	/* Skip the time-stamps that have not been captured yet */
+	if ((start == 0ULL) || (end < start))
+		return;
+
+	psci_stat_hist_add(cpu_idx, stat_idx, type, ticks_to_ns(end - start));
+}
+
+/*******************************************************************************
+ * This function accounts for the latencies of the PSCI call that the current
+ * CPU returns from, if it entered a low power state. It is called once the
+ * RT_INSTR_EXIT_PSCI time-stamp has been captured, with caches enabled.
+ ******************************************************************************/
+void psci_stats_update_latency(void)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+	int stat_idx = psci_cpu_stat_hist[cpu_idx].exit_stat_idx;
+
+	if (stat_idx == 0)
+		return;
+
+	psci_cpu_stat_hist[cpu_idx].exit_stat_idx = 0;
+	stat_idx--;
+
+	psci_stat_hist_add_latency(cpu_idx, stat_idx,
+				   PSCI_STAT_HIST_ENTRY_LATENCY,
+				   RT_INSTR_ENTER_PSCI,
+				   RT_INSTR_ENTER_HW_LOW_PWR);
+	psci_stat_hist_add_latency(cpu_idx, stat_idx,
+				   PSCI_STAT_HIST_EXIT_LATENCY,
+				   RT_INSTR_EXIT_HW_LOW_PWR,
+				   RT_INSTR_EXIT_PSCI);
+}
+#endif /* ENABLE_RUNTIME_INSTRUMENTATION */
+
+/*
+ * Handle PSCI_STAT_HIST_GET_64 and PSCI_STAT_HIST_RESET_64.
+ *
+ * For PSCI_STAT_HIST_GET_64, the caller gives the MPIDR of the CPU in x1, a
+ * power_state parameter in x2, the histogram in x3 and the bucket in x4. The
+ * histograms are those of the CPU power level, selected by the local state
+ * of the CPU in power_state. The caller gets back the count of the bucket in
+ * x1.
+ *
+ * PSCI_STAT_HIST_RESET_64 clears the histograms of all the CPUs. A CPU that
+ * leaves a low power state at the same time may keep the count of one
+ * bucket.
+ */
+uintptr_t psci_stat_hist_smc_handler(uint32_t smc_fid,
+				     u_register_t x1,
+				     u_register_t x2,
+				     u_register_t x3,
+				     u_register_t x4,
+				     void *cookie,
+				     void *handle,
+				     u_register_t flags)
+{
+	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+	plat_local_state_t local_state;
+	unsigned int cpu_idx, i;
+	int rc, stat_idx;
+
+	if (smc_fid == PSCI_STAT_HIST_RESET_64) {
+		for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+			zeromem(psci_cpu_stat_hist[i].hist,
+				sizeof(psci_cpu_stat_hist[i].hist));
+		}
+		SMC_RET1(handle, SMC_OK);
+	}
+
+	if (smc_fid != PSCI_STAT_HIST_GET_64)
+		SMC_RET1(handle, SMC_UNK);
+
+	rc = plat_core_pos_by_mpidr(x1);
+	if (rc < 0)
+		SMC_RET1(handle, -EINVAL);
+	cpu_idx = (unsigned int)rc;
+
+	if ((x3 >= PSCI_STAT_HIST_TYPES) || (x4 >= PSCI_STAT_HIST_BUCKETS))
+		SMC_RET1(handle, -EINVAL);
+
+	/* Validate the power_state parameter as PSCI_STAT_COUNT does */
+	if (psci_plat_pm_ops->translate_power_state_by_mpidr == NULL)
+		rc = psci_validate_power_state((unsigned int)x2, &state_info);
+	else
+		rc = psci_plat_pm_ops->translate_power_state_by_mpidr(
+				x1, (unsigned int)x2, &state_info);
+
+	if (rc != PSCI_E_SUCCESS)
+		SMC_RET1(handle, -EINVAL);
+
+	local_state = state_info.pwr_domain_state[PSCI_CPU_PWR_LVL];
+	if (is_local_state_run(local_state) != 0)
+		SMC_RET1(handle, -EINVAL);
+
+	stat_idx = get_stat_idx(local_state, PSCI_CPU_PWR_LVL);
+
+	SMC_RET2(handle, SMC_OK,
+		 psci_cpu_stat_hist[cpu_idx].hist[stat_idx][x3][x4]);
+}
+#endif /* ENABLE_PSCI_STAT_HIST */
@@ -154,6 +154,7 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 {
 	int skip_wfi = 0;
 	int idx = (int) plat_my_core_pos();
+	unsigned int lockless = 0U;
 
 	/*
 	 * This function must only be called on platforms where the
@@ -162,30 +163,44 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
-	/*
-	 * This function acquires the lock corresponding to each power
-	 * level so that by the time all locks are taken, the system topology
-	 * is snapshot and state management can be done safely.
-	 */
-	psci_acquire_pwr_domain_locks(end_pwrlvl,
-				      idx);
+#if PSCI_LOCKLESS_COORDINATION
+	if (read_isr_el1() != 0U)
+		return;
 
 	/*
-	 * We check if there are any pending interrupts after the delay
-	 * introduced by lock contention to increase the chances of early
-	 * detection that a wake-up interrupt has fired.
+	 * If other CPUs of the cluster are running, only the state of this
+	 * CPU changes and the locks are not needed.
 	 */
-	if (read_isr_el1() != 0U) {
-		skip_wfi = 1;
-		goto exit;
-	}
+	lockless = psci_lockless_state_coordination(end_pwrlvl, state_info);
+#endif
 
-	/*
-	 * This function is passed the requested state info and
-	 * it returns the negotiated state info for each power level upto
-	 * the end level specified.
-	 */
-	psci_do_state_coordination(end_pwrlvl, state_info);
+	if (lockless == 0U) {
+		/*
+		 * This function acquires the lock corresponding to each power
+		 * level so that by the time all locks are taken, the system
+		 * topology is snapshot and state management can be done
+		 * safely.
+		 */
+		psci_acquire_pwr_domain_locks(end_pwrlvl,
+					      idx);
+
+		/*
+		 * We check if there are any pending interrupts after the delay
+		 * introduced by lock contention to increase the chances of
+		 * early detection that a wake-up interrupt has fired.
+		 */
+		if (read_isr_el1() != 0U) {
+			skip_wfi = 1;
+			goto exit;
+		}
+
+		/*
+		 * This function is passed the requested state info and
+		 * it returns the negotiated state info for each power level
+		 * upto the end level specified.
+		 */
+		psci_do_state_coordination(end_pwrlvl, state_info);
+	}
 
 #if ENABLE_PSCI_STAT
 	/* Update the last cpu for each level till end_pwrlvl */
@@ -212,8 +227,9 @@ exit:
 	 * Release the locks corresponding to each power level in the
 	 * reverse order to which they were acquired.
 	 */
-	psci_release_pwr_domain_locks(end_pwrlvl,
-				  idx);
+	if (lockless == 0U)
+		psci_release_pwr_domain_locks(end_pwrlvl,
+					      idx);
 	if (skip_wfi == 1)
 		return;
 
@@ -90,6 +90,40 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	size_t pages = size >> PAGE_SIZE_SHIFT;
+
+	assert(IS_PAGE_ALIGNED(va));
+	assert((size % PAGE_SIZE) == 0U);
+	assert((xlat_regime == EL1_EL0_REGIME) ||
+	       (xlat_regime == EL2_REGIME));
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if (pages > XLAT_TLBI_VA_RANGE_MAX_PAGES) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbiallis();
+		} else {
+			tlbiallhis();
+		}
+		return;
+	}
+
+	for (; pages > 0U; pages--) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbimvaais(TLBI_ADDR(va));
+		} else {
+			tlbimvahis(TLBI_ADDR(va));
+		}
+		va += PAGE_SIZE;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
@@ -116,6 +150,16 @@ void xlat_arch_tlbi_va_sync(void)
 	isb();
 }
 
+void xlat_arch_tables_sync(void)
+{
+	dsbish();
+}
+
+void xlat_arch_clean_dcache_range(uintptr_t addr, size_t size)
+{
+	clean_dcache_range(addr, size);
+}
+
 unsigned int xlat_arch_current_el(void)
 {
 	if (IS_IN_HYP()) {
@@ -167,6 +167,114 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+/*
+ * Returns true if the TLBI range operations of ARMv8.4-TLBI are implemented.
+ */
+static bool is_tlbi_range_present(void)
+{
+	return ((read_id_aa64isar0_el1() >> ID_AA64ISAR0_TLB_SHIFT) &
+		ID_AA64ISAR0_TLB_MASK) >= ID_AA64ISAR0_TLB_RANGE;
+}
+
+static void tlbi_va_regime(uintptr_t va, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbivaae1is(TLBI_ADDR(va));
+	} else if (xlat_regime == EL2_REGIME) {
+		tlbivae2is(TLBI_ADDR(va));
+	} else {
+		tlbivae3is(TLBI_ADDR(va));
+	}
+}
+
+static void tlbi_range_regime(uint64_t arg, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbirvaae1is(arg);
+	} else if (xlat_regime == EL2_REGIME) {
+		tlbirvae2is(arg);
+	} else {
+		tlbirvae3is(arg);
+	}
+}
+
+static void tlbi_all_regime(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbivmalle1is();
+	} else if (xlat_regime == EL2_REGIME) {
+		tlbialle2is();
+	} else {
+		tlbialle3is();
+	}
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	unsigned long long pages = (unsigned long long)size >> PAGE_SIZE_SHIFT;
+	unsigned long long range_pages;
+	unsigned int scale, num;
+
+	assert(IS_PAGE_ALIGNED(va));
+	assert((size % PAGE_SIZE) == 0U);
+
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+	}
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if (!is_tlbi_range_present()) {
+		if (pages > XLAT_TLBI_VA_RANGE_MAX_PAGES) {
+			tlbi_all_regime(xlat_regime);
+			return;
+		}
+
+		for (; pages > 0U; pages--) {
+			tlbi_va_regime(va, xlat_regime);
+			va += PAGE_SIZE;
+		}
+		return;
+	}
+
+	/*
+	 * A range operation covers an even number of pages, so an odd page is
+	 * invalidated on its own. The rest is covered by as few operations as
+	 * possible, starting with the biggest scale that fits.
+	 */
+	while (pages > 0U) {
+		if ((pages & 1U) != 0U) {
+			tlbi_va_regime(va, xlat_regime);
+			va += PAGE_SIZE;
+			pages--;
+			continue;
+		}
+
+		scale = TLBI_RANGE_SCALE_MAX;
+		while ((pages >> ((5U * scale) + 1U)) == 0U)
+			scale--;
+
+		range_pages = pages >> ((5U * scale) + 1U);
+		num = (range_pages > (TLBI_RANGE_NUM_MAX + 1U)) ?
+			TLBI_RANGE_NUM_MAX : (unsigned int)range_pages - 1U;
+
+		tlbi_range_regime(TLBI_RANGE_ADDR(va, num, scale), xlat_regime);
+
+		range_pages = TLBI_RANGE_PAGES(num, scale);
+		va += (uintptr_t)(range_pages << PAGE_SIZE_SHIFT);
+		pages -= range_pages;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
@@ -190,6 +298,16 @@ void xlat_arch_tlbi_va_sync(void)
 	isb();
 }
 
+void xlat_arch_tables_sync(void)
+{
+	dsbish();
+}
+
+void xlat_arch_clean_dcache_range(uintptr_t addr, size_t size)
+{
+	clean_dcache_range(addr, size);
+}
+
 unsigned int xlat_arch_current_el(void)
 {
 	unsigned int el = (unsigned int)GET_EL(read_CurrentEl());
@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-#include <arch_helpers.h>
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
@@ -22,7 +21,7 @@
 static inline void xlat_clean_dcache_range(uintptr_t addr, size_t size)
 {
 	if (is_dcache_enabled())
-		clean_dcache_range(addr, size);
+		xlat_arch_clean_dcache_range(addr, size);
 }
 
 #if PLAT_XLAT_TABLES_DYNAMIC
@@ -233,7 +232,8 @@ typedef enum {
 
 /*
  * Recursive function that writes to the translation tables and unmaps the
- * specified region.
+ * specified region. The caller is responsible for invalidating the TLB entries
+ * of the region afterwards.
  */
 static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
@@ -327,7 +327,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -344,11 +343,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			/*
 			 * If the subtable is now empty, remove its reference.
 			 */
-			if (xlat_table_is_empty(ctx, subtable)) {
+			if (xlat_table_is_empty(ctx, subtable))
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
-			}
 
 		} else {
 			assert(action == ACTION_NONE);
@@ -615,6 +611,304 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 	return table_idx_va - 1U;
 }
 
+#if XLAT_TABLES_COALESCE
+
+/*
+ * Returns true if the `count` entries at `table` are block or page descriptors
+ * of the given level with the same attributes, and map consecutive physical
+ * addresses starting at an address aligned to the total size they map.
+ */
+static bool xlat_entries_are_uniform(const uint64_t *table, unsigned int count,
+				     unsigned int level)
+{
+	uint64_t leaf_type = (level == XLAT_TABLE_LEVEL_MAX) ?
+			     PAGE_DESC : BLOCK_DESC;
+	unsigned long long entry_size = XLAT_BLOCK_SIZE(level);
+	unsigned long long pa = table[0] & TABLE_ADDR_MASK;
+
+	if ((pa & ((entry_size * count) - 1U)) != 0U)
+		return false;
+
+	for (unsigned int i = 0U; i < count; i++) {
+		if ((table[i] & DESC_MASK) != leaf_type)
+			return false;
+
+		if ((table[i] & ~TABLE_ADDR_MASK) !=
+		    (table[0] & ~TABLE_ADDR_MASK))
+			return false;
+
+		if ((table[i] & TABLE_ADDR_MASK) != (pa + (i * entry_size)))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Returns true if the regions that overlap the given VA range allow it to be
+ * mapped by a single descriptor, or by a contiguous run of descriptors.
+ *
+ * The granularity of all the regions must allow it. Also, a dynamic region
+ * must contain the whole range, so that removing a dynamic region never needs
+ * to split a descriptor.
+ */
+static bool xlat_range_can_merge(const xlat_ctx_t *ctx, uintptr_t base_va,
+				 size_t size)
+{
+	uintptr_t end_va = base_va + size - 1U;
+
+	for (const mmap_region_t *mm = ctx->mmap; mm->size != 0U; ++mm) {
+		uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+
+		if ((mm->base_va > end_va) || (mm_end_va < base_va))
+			continue;
+
+		if (mm->granularity < size)
+			return false;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+		if (((mm->attr & MT_DYNAMIC) != 0U) &&
+		    ((mm->base_va > base_va) || (mm_end_va < end_va)))
+			return false;
+#endif
+	}
+
+	return true;
+}
+
+/*
+ * Recursive function that replaces the subtables of the given table whose
+ * entries can be described by a single block descriptor with that block
+ * descriptor. It must only be used before the translation tables are in use.
+ */
+static void xlat_tables_coalesce(xlat_ctx_t *ctx, uintptr_t table_base_va,
+				 uint64_t *table_base,
+				 unsigned int table_entries,
+				 unsigned int level)
+{
+	uintptr_t table_idx_va = table_base_va;
+	uint64_t *subtable;
+	uint64_t desc;
+
+	if (level == XLAT_TABLE_LEVEL_MAX)
+		return;
+
+	for (unsigned int table_idx = 0U; table_idx < table_entries;
+	     table_idx++, table_idx_va += XLAT_BLOCK_SIZE(level)) {
+
+		desc = table_base[table_idx];
+		if ((desc & DESC_MASK) != TABLE_DESC)
+			continue;
+
+		subtable = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+
+		/* Coalesce the finer levels first. */
+		xlat_tables_coalesce(ctx, table_idx_va, subtable,
+				     XLAT_TABLE_ENTRIES, level + 1U);
+
+		if ((level < MIN_LVL_BLOCK_DESC) ||
+		    !xlat_entries_are_uniform(subtable, XLAT_TABLE_ENTRIES,
+					      level + 1U) ||
+		    !xlat_range_can_merge(ctx, table_idx_va,
+					  XLAT_BLOCK_SIZE(level)))
+			continue;
+
+		/*
+		 * Block and page descriptors only differ in their type, and
+		 * the first entry of the subtable maps the base of the block.
+		 */
+		table_base[table_idx] = (subtable[0] & ~(uint64_t)DESC_MASK) |
+					BLOCK_DESC;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+		/* Release the subtable so that dynamic regions can use it. */
+		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
+			subtable[i] = INVALID_DESC;
+		ctx->tables_mapped_regions[xlat_table_get_index(ctx, subtable)] = 0;
+#endif
+		ctx->coalesced_tables++;
+	}
+
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)table_base,
+				table_entries * sizeof(uint64_t));
+#endif
+}
+
+/*
+ * Recursive function that finds the runs of XLAT_CONTIGUOUS_ENTRIES aligned
+ * entries that can be marked with the contiguous hint. If `mm` isn't NULL,
+ * only runs inside that region are considered.
+ *
+ * If `live` is false, the contiguous hint is set right away. Otherwise, the
+ * tables may be in use and the entries of each run are made invalid instead,
+ * and xlat_tables_make_contig() must be used to write them back with the hint
+ * once their TLB entries have been invalidated. The valid bit is the only one
+ * that is cleared, so that the rest of the descriptor is kept. Returns the
+ * number of runs found.
+ */
+static unsigned int xlat_tables_mark_contig(xlat_ctx_t *ctx,
+					    const mmap_region_t *mm,
+					    bool live, uintptr_t table_base_va,
+					    uint64_t *table_base,
+					    unsigned int table_entries,
+					    unsigned int level)
+{
+	unsigned long long run_size = XLAT_BLOCK_SIZE(level) *
+				      XLAT_CONTIGUOUS_ENTRIES;
+	unsigned int runs = 0U;
+	uintptr_t table_idx_va;
+	uint64_t desc;
+
+	for (unsigned int table_idx = 0U; table_idx < table_entries;
+	     table_idx++) {
+
+		table_idx_va = table_base_va +
+			       (table_idx * XLAT_BLOCK_SIZE(level));
+		desc = table_base[table_idx];
+
+		if ((mm != NULL) &&
+		    ((table_idx_va + XLAT_BLOCK_SIZE(level) - 1U <
+		      mm->base_va) ||
+		     (table_idx_va > mm->base_va + mm->size - 1U)))
+			continue;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			runs += xlat_tables_mark_contig(ctx, mm, live,
+				table_idx_va,
+				(uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK),
+				XLAT_TABLE_ENTRIES, level + 1U);
+			continue;
+		}
+
+		if (((table_idx % XLAT_CONTIGUOUS_ENTRIES) != 0U) ||
+		    ((table_idx + XLAT_CONTIGUOUS_ENTRIES) > table_entries) ||
+		    ((desc & UPPER_ATTRS(CONT_HINT)) != 0U))
+			continue;
+
+		if ((mm != NULL) &&
+		    ((table_idx_va < mm->base_va) ||
+		     (table_idx_va + run_size - 1U >
+		      mm->base_va + mm->size - 1U)))
+			continue;
+
+		if (!xlat_entries_are_uniform(&table_base[table_idx],
+					      XLAT_CONTIGUOUS_ENTRIES, level) ||
+		    !xlat_range_can_merge(ctx, table_idx_va, run_size))
+			continue;
+
+		for (unsigned int i = 0U; i < XLAT_CONTIGUOUS_ENTRIES; i++) {
+			if (live) {
+				table_base[table_idx + i] &=
+					~(uint64_t)VALID_DESC;
+			} else {
+				table_base[table_idx + i] |=
+					UPPER_ATTRS(CONT_HINT);
+			}
+		}
+		runs++;
+	}
+
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)table_base,
+				table_entries * sizeof(uint64_t));
+#endif
+	return runs;
+}
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+/*
+ * Recursive function that writes back the entries of the given region that
+ * xlat_tables_mark_contig() has made invalid, with the contiguous hint set.
+ */
+static void xlat_tables_make_contig(const mmap_region_t *mm,
+				    uintptr_t table_base_va,
+				    uint64_t *table_base,
+				    unsigned int table_entries,
+				    unsigned int level)
+{
+	uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+	uintptr_t table_idx_va;
+	uint64_t desc;
+
+	for (unsigned int table_idx = 0U; table_idx < table_entries;
+	     table_idx++) {
+
+		table_idx_va = table_base_va +
+			       (table_idx * XLAT_BLOCK_SIZE(level));
+		desc = table_base[table_idx];
+
+		if ((table_idx_va + XLAT_BLOCK_SIZE(level) - 1U <
+		     mm->base_va) || (table_idx_va > mm_end_va))
+			continue;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			xlat_tables_make_contig(mm, table_idx_va,
+				(uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK),
+				XLAT_TABLE_ENTRIES, level + 1U);
+		} else if ((desc != INVALID_DESC) &&
+			   ((desc & VALID_DESC) == 0U)) {
+			table_base[table_idx] = desc | VALID_DESC |
+						UPPER_ATTRS(CONT_HINT);
+		}
+	}
+
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)table_base,
+				table_entries * sizeof(uint64_t));
+#endif
+}
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+
+#endif /* XLAT_TABLES_COALESCE */
+
+/*
+ * Returns the number of regions in the mmap array of the given context. The
+ * regions are stored at the start of the array, followed by empty entries.
+ */
+static int mmap_region_count(const xlat_ctx_t *ctx)
+{
+	int lo = 0, hi = ctx->mmap_num;
+
+	while (lo < hi) {
+		int mid = lo + ((hi - lo) / 2);
+
+		if (ctx->mmap[mid].size != 0U)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Returns the position of the first of the `count` regions of the mmap array
+ * that isn't ordered before a region with the given end VA and size. This is
+ * where such a region has to be inserted, see mmap_add_region_ctx().
+ */
+static int mmap_region_find(const xlat_ctx_t *ctx, int count, uintptr_t end_va,
+			    size_t size)
+{
+	int lo = 0, hi = count;
+
+	while (lo < hi) {
+		int mid = lo + ((hi - lo) / 2);
+		const mmap_region_t *mm = &ctx->mmap[mid];
+		uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+
+		if ((mm_end_va < end_va) ||
+		    ((mm_end_va == end_va) && (mm->size < size)))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
 /*
  * Function that verifies that a region can be mapped.
  * Returns:
@@ -721,9 +1015,10 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap, *mm_destination;
+	mmap_region_t *mm_cursor, *mm_destination;
 	const mmap_region_t *mm_end = ctx->mmap + ctx->mmap_num;
 	const mmap_region_t *mm_last;
+	int count;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
 	int ret;
@@ -764,25 +1059,13 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	 * previously.
 	 *
 	 * Overlapping is only allowed for static regions.
+	 *
+	 * As the array is sorted, the place and the last entry marker can be
+	 * found with binary searches.
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
-
-	/*
-	 * Find the last entry marker in the mmap
-	 */
-	mm_last = ctx->mmap;
-	while ((mm_last->size != 0U) && (mm_last < mm_end)) {
-		++mm_last;
-	}
+	count = mmap_region_count(ctx);
+	mm_cursor = &ctx->mmap[mmap_region_find(ctx, count, end_va, mm->size)];
+	mm_last = &ctx->mmap[count];
 
 	/*
 	 * Check if we have enough space in the memory mapping table.
@@ -825,10 +1108,11 @@ void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap;
-	const mmap_region_t *mm_last = mm_cursor + ctx->mmap_num;
+	mmap_region_t *mm_cursor;
+	const mmap_region_t *mm_last = ctx->mmap + ctx->mmap_num;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
+	int count;
 	int ret;
 
 	/* Nothing to do */
@@ -846,16 +1130,8 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * Find the adequate entry in the mmap array in the same way done for
 	 * static regions in mmap_add_region_ctx().
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
+	count = mmap_region_count(ctx);
+	mm_cursor = &ctx->mmap[mmap_region_find(ctx, count, end_va, mm->size)];
 
 	/* Make room for new region by moving other regions up by one place */
 	(void)memmove(mm_cursor + 1U, mm_cursor,
@@ -911,6 +1187,9 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 				ctx->base_table_entries * sizeof(uint64_t));
 #endif
+			xlat_arch_tlbi_va_range(mm->base_va,
+				end_va - mm->base_va + 1U, ctx->xlat_regime);
+			xlat_arch_tlbi_va_sync();
 			return -ENOMEM;
 		}
 
@@ -920,7 +1199,26 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 		 * because new table/block/page descriptors only replace old
 		 * invalid descriptors, that aren't TLB cached.
 		 */
-		dsbishst();
+		xlat_arch_tables_sync();
+
+#if XLAT_TABLES_COALESCE
+		/*
+		 * The new entries may have been cached in the TLBs already, so
+		 * setting the contiguous hint requires a break-before-make
+		 * sequence on them.
+		 */
+		if (xlat_tables_mark_contig(ctx, mm_cursor, true, 0U,
+				ctx->base_table, ctx->base_table_entries,
+				ctx->base_level) != 0U) {
+			xlat_arch_tlbi_va_range(mm_cursor->base_va,
+				mm_cursor->size, ctx->xlat_regime);
+			xlat_arch_tlbi_va_sync();
+
+			xlat_tables_make_contig(mm_cursor, 0U, ctx->base_table,
+				ctx->base_table_entries, ctx->base_level);
+			xlat_arch_tables_sync();
+		}
+#endif
 	}
 
 	if (end_pa > ctx->max_pa)
@@ -943,22 +1241,24 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size)
 {
-	mmap_region_t *mm = ctx->mmap;
-	const mmap_region_t *mm_last = mm + ctx->mmap_num;
+	mmap_region_t *mm;
+	const mmap_region_t *mm_last = ctx->mmap + ctx->mmap_num;
 	int update_max_va_needed = 0;
 	int update_max_pa_needed = 0;
+	int count;
 
 	/* Check sanity of mmap array. */
-	assert(mm[ctx->mmap_num].size == 0U);
+	assert(mm_last->size == 0U);
 
-	while (mm->size != 0U) {
-		if ((mm->base_va == base_va) && (mm->size == size))
-			break;
-		++mm;
-	}
+	/*
+	 * Regions with the same end VA and size are the same region, which can
+	 * only be at the place where it would be inserted.
+	 */
+	count = mmap_region_count(ctx);
+	mm = &ctx->mmap[mmap_region_find(ctx, count, base_va + size - 1U, size)];
 
 	/* Check that the region was found */
-	if (mm->size == 0U)
+	if ((size == 0U) || (mm->size != size) || (mm->base_va != base_va))
 		return -EINVAL;
 
 	/* If the region is static it can't be removed */
@@ -980,6 +1280,13 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 			ctx->base_table_entries * sizeof(uint64_t));
 #endif
+		/*
+		 * Invalidate the TLB entries of the whole region at once. This
+		 * also covers the tables that have been removed, as they were
+		 * used to translate addresses of the region.
+		 */
+		xlat_arch_tlbi_va_range(mm->base_va, mm->size,
+					ctx->xlat_regime);
 		xlat_arch_tlbi_va_sync();
 	}
 
@@ -1056,6 +1363,17 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
 		mm++;
 	}
 
+#if XLAT_TABLES_COALESCE
+	/*
+	 * The translation tables aren't in use yet, so they can be changed
+	 * without any TLB maintenance.
+	 */
+	xlat_tables_coalesce(ctx, 0U, ctx->base_table,
+			     ctx->base_table_entries, ctx->base_level);
+	(void)xlat_tables_mark_contig(ctx, NULL, false, 0U, ctx->base_table,
+				      ctx->base_table_entries, ctx->base_level);
+#endif
+
 	assert(ctx->pa_max_address <= xlat_arch_get_max_supported_pa());
 	assert(ctx->max_va <= ctx->va_max_address);
 	assert(ctx->max_pa <= ctx->pa_max_address);
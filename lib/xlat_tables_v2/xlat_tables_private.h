@@ -57,12 +57,46 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Invalidate all TLB entries that match the given page-aligned virtual address
+ * range, like calling xlat_arch_tlbi_va() for each page of the range. Depending
+ * on the architecture and on the size of the range, this may use TLBI range
+ * operations or invalidate all the TLB entries of the translation regime.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
+/*
+ * Ranges bigger than this number of pages are invalidated with a single TLBI
+ * operation that affects the whole translation regime, unless TLBI range
+ * operations are available.
+ */
+#define XLAT_TLBI_VA_RANGE_MAX_PAGES	U(64)
+
+/*
+ * Number of aligned adjacent entries that must be marked with the contiguous
+ * hint together.
+ */
+#define XLAT_CONTIGUOUS_ENTRIES		U(16)
+
 /*
  * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
+/*
+ * Ensure that the translation table entries written so far are observed by
+ * all the PEs in the Inner Shareable domain, including their translation table
+ * walks.
+ */
+void xlat_arch_tables_sync(void);
+
+/*
+ * Clean the data cache lines that hold the given range of translation table
+ * memory to the Point of Coherency.
+ */
+void xlat_arch_clean_dcache_range(uintptr_t addr, size_t size);
+
 /* Print VA, PA, size and attributes of all regions in the mmap array. */
 void xlat_mmap_print(const mmap_region_t *mmap);
 
@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-#include <arch_helpers.h>
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
@@ -94,6 +93,9 @@ static void xlat_desc_print(const xlat_ctx_t *ctx, uint64_t desc)
 	}
 
 	printf(((LOWER_ATTRS(NS) & desc) != 0ULL) ? "-NS" : "-S");
+
+	if ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL)
+		printf("-CONT");
 }
 
 static const char * const level_spacers[] = {
@@ -229,6 +231,20 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 	VERBOSE("  Used %d sub-tables out of %d (spare: %d)\n",
 		used_page_tables, ctx->tables_num,
 		ctx->tables_num - used_page_tables);
+#if XLAT_TABLES_COALESCE
+	/*
+	 * Coalesced sub-tables are only returned to the pool of free tables
+	 * when dynamic mapping support is enabled.
+	 */
+#if PLAT_XLAT_TABLES_DYNAMIC
+	VERBOSE("  Freed %d sub-tables (%u KB) by coalescing them into blocks\n",
+		ctx->coalesced_tables,
+		(unsigned int)ctx->coalesced_tables * (XLAT_TABLE_SIZE / 1024U));
+#else
+	VERBOSE("  Coalesced %d sub-tables into blocks\n",
+		ctx->coalesced_tables);
+#endif
+#endif
 
 	xlat_tables_print_internal(ctx, 0U, ctx->base_table,
 				   ctx->base_table_entries, ctx->base_level);
@@ -316,6 +332,53 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 }
 
 
+/*
+ * Returns the MT_* attributes that are encoded in the given block or page
+ * descriptor.
+ */
+static uint32_t xlat_desc_get_attributes(const xlat_ctx_t *ctx, uint64_t desc)
+{
+	uint32_t attributes = 0U;
+
+	uint64_t attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
+
+	if (attr_index == ATTR_IWBWA_OWBWA_NTR_INDEX) {
+		attributes |= MT_MEMORY;
+	} else if (attr_index == ATTR_NON_CACHEABLE_INDEX) {
+		attributes |= MT_NON_CACHEABLE;
+	} else {
+		assert(attr_index == ATTR_DEVICE_INDEX);
+		attributes |= MT_DEVICE;
+	}
+
+	uint64_t ap2_bit = (desc >> AP2_SHIFT) & 1U;
+
+	if (ap2_bit == AP2_RW)
+		attributes |= MT_RW;
+
+	if (ctx->xlat_regime == EL1_EL0_REGIME) {
+		uint64_t ap1_bit = (desc >> AP1_SHIFT) & 1U;
+
+		if (ap1_bit == AP1_ACCESS_UNPRIVILEGED)
+			attributes |= MT_USER;
+	}
+
+	uint64_t ns_bit = (desc >> NS_SHIFT) & 1U;
+
+	if (ns_bit == 1U)
+		attributes |= MT_NS;
+
+	uint64_t xn_mask = xlat_arch_regime_get_xn_desc(ctx->xlat_regime);
+
+	if ((desc & xn_mask) == xn_mask) {
+		attributes |= MT_EXECUTE_NEVER;
+	} else {
+		assert((desc & xn_mask) == 0U);
+	}
+
+	return attributes;
+}
+
 static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 		uintptr_t base_va, uint32_t *attributes, uint64_t **table_entry,
 		unsigned long long *addr_pa, unsigned int *table_level)
@@ -368,68 +431,73 @@ static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 #endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
 
 	assert(attributes != NULL);
-	*attributes = 0U;
+	*attributes = xlat_desc_get_attributes(ctx, desc);
 
-	uint64_t attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
-
-	if (attr_index == ATTR_IWBWA_OWBWA_NTR_INDEX) {
-		*attributes |= MT_MEMORY;
-	} else if (attr_index == ATTR_NON_CACHEABLE_INDEX) {
-		*attributes |= MT_NON_CACHEABLE;
-	} else {
-		assert(attr_index == ATTR_DEVICE_INDEX);
-		*attributes |= MT_DEVICE;
-	}
+	return 0;
+}
 
-	uint64_t ap2_bit = (desc >> AP2_SHIFT) & 1U;
 
-	if (ap2_bit == AP2_RW)
-		*attributes |= MT_RW;
+int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
+				uint32_t *attr)
+{
+	return xlat_get_mem_attributes_internal(ctx, base_va, attr,
+				NULL, NULL, NULL);
+}
 
-	if (ctx->xlat_regime == EL1_EL0_REGIME) {
-		uint64_t ap1_bit = (desc >> AP1_SHIFT) & 1U;
 
-		if (ap1_bit == AP1_ACCESS_UNPRIVILEGED)
-			*attributes |= MT_USER;
-	}
+/*
+ * Look up the last level translation table that maps the page at the given
+ * virtual address, and return a pointer to the entry of that page. Unlike
+ * find_xlat_table_entry(), the entry itself may be invalid. On success, the
+ * number of entries of the table from that entry onwards, limited to
+ * `max_pages`, is stored in `*run`. Returns NULL if the page isn't mapped by a
+ * last level translation table.
+ *
+ * This allows a range of pages to be walked with one lookup per last level
+ * translation table instead of one lookup per page.
+ */
+static uint64_t *find_xlat_table_entry_run(const xlat_ctx_t *ctx,
+					   uintptr_t virtual_addr,
+					   size_t max_pages, size_t *run)
+{
+	unsigned long long virt_addr_space_size =
+		(unsigned long long)ctx->va_max_address + 1U;
+	uint64_t *table = ctx->base_table;
+	unsigned int entries = ctx->base_table_entries;
+	uint64_t idx, desc;
 
-	uint64_t ns_bit = (desc >> NS_SHIFT) & 1U;
+	for (unsigned int level =
+			GET_XLAT_TABLE_LEVEL_BASE(virt_addr_space_size);
+	     level < XLAT_TABLE_LEVEL_MAX; ++level) {
 
-	if (ns_bit == 1U)
-		*attributes |= MT_NS;
+		idx = XLAT_TABLE_IDX(virtual_addr, level);
+		if (idx >= entries)
+			return NULL;
 
-	uint64_t xn_mask = xlat_arch_regime_get_xn_desc(ctx->xlat_regime);
+		desc = table[idx];
+		if ((desc & DESC_MASK) != TABLE_DESC)
+			return NULL;
 
-	if ((desc & xn_mask) == xn_mask) {
-		*attributes |= MT_EXECUTE_NEVER;
-	} else {
-		assert((desc & xn_mask) == 0U);
+		table = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+		entries = XLAT_TABLE_ENTRIES;
 	}
 
-	return 0;
-}
+	idx = XLAT_TABLE_IDX(virtual_addr, XLAT_TABLE_LEVEL_MAX);
+	*run = MIN(max_pages, (size_t)(XLAT_TABLE_ENTRIES - idx));
 
-
-int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
-				uint32_t *attr)
-{
-	return xlat_get_mem_attributes_internal(ctx, base_va, attr,
-				NULL, NULL, NULL);
+	return &table[idx];
 }
 
-
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size, uint32_t attr)
 {
-	/* Note: This implementation isn't optimized. */
+	uint64_t *entry;
+	uintptr_t va;
+	size_t pages_left, run;
 
 	assert(ctx != NULL);
 	assert(ctx->initialized);
 
-	unsigned long long virt_addr_space_size =
-		(unsigned long long)ctx->va_max_address + 1U;
-	assert(virt_addr_space_size > 0U);
-
 	if (!IS_PAGE_ALIGNED(base_va)) {
 		WARN("%s: Address 0x%lx is not aligned on a page boundary.\n",
 		     __func__, base_va);
@@ -458,109 +526,115 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	VERBOSE("Changing memory attributes of %zu pages starting from address 0x%lx...\n",
 		pages_count, base_va);
 
-	uintptr_t base_va_original = base_va;
-
 	/*
+	 * The range is walked one last level table at a time: each table is
+	 * looked up once and then its consecutive entries are used directly.
+	 *
 	 * Sanity checks.
 	 */
-	for (size_t i = 0U; i < pages_count; ++i) {
-		const uint64_t *entry;
-		uint64_t desc, attr_index;
-		unsigned int level;
-
-		entry = find_xlat_table_entry(base_va,
-					      ctx->base_table,
-					      ctx->base_table_entries,
-					      virt_addr_space_size,
-					      &level);
+	va = base_va;
+	for (pages_left = pages_count; pages_left > 0U; pages_left -= run) {
+		entry = find_xlat_table_entry_run(ctx, va, pages_left, &run);
 		if (entry == NULL) {
-			WARN("Address 0x%lx is not mapped.\n", base_va);
+			WARN("Address 0x%lx is not mapped at the right granularity.\n",
+			     va);
+			WARN("Granularity should be 0x%x.\n", PAGE_SIZE);
 			return -EINVAL;
 		}
 
-		desc = *entry;
+		for (size_t i = 0U; i < run; i++) {
+			uint64_t desc = entry[i];
+			uint64_t attr_index;
 
-		/*
-		 * Check that all the required pages are mapped at page
-		 * granularity.
-		 */
-		if (((desc & DESC_MASK) != PAGE_DESC) ||
-			(level != XLAT_TABLE_LEVEL_MAX)) {
-			WARN("Address 0x%lx is not mapped at the right granularity.\n",
-			     base_va);
-			WARN("Granularity is 0x%llx, should be 0x%x.\n",
-			     (unsigned long long)XLAT_BLOCK_SIZE(level), PAGE_SIZE);
-			return -EINVAL;
-		}
+			if ((desc & DESC_MASK) != PAGE_DESC) {
+				WARN("Address 0x%lx is not mapped.\n", va);
+				return -EINVAL;
+			}
 
-		/*
-		 * If the region type is device, it shouldn't be executable.
-		 */
-		attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
-		if (attr_index == ATTR_DEVICE_INDEX) {
-			if ((attr & MT_EXECUTE_NEVER) == 0U) {
+			if ((desc & UPPER_ATTRS(CONT_HINT)) != 0U) {
+				WARN("Address 0x%lx is mapped with the contiguous hint.\n",
+				     va);
+				return -EINVAL;
+			}
+
+			/*
+			 * If the region type is device, it shouldn't be
+			 * executable.
+			 */
+			attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
+			if ((attr_index == ATTR_DEVICE_INDEX) &&
+			    ((attr & MT_EXECUTE_NEVER) == 0U)) {
 				WARN("Setting device memory as executable at address 0x%lx.",
-				     base_va);
+				     va);
 				return -EINVAL;
 			}
-		}
 
-		base_va += PAGE_SIZE;
+			va += PAGE_SIZE;
+		}
 	}
 
-	/* Restore original value. */
-	base_va = base_va_original;
-
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-
-		uint32_t old_attr = 0U, new_attr;
-		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
-
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
+	/*
+	 * The break-before-make sequence requires writing an invalid
+	 * descriptor and making sure that the system sees the change before
+	 * writing the new descriptor. It is done for the whole range at once,
+	 * so that the TLB entries of the range are invalidated together.
+	 *
+	 * Only the valid bit of the descriptors is cleared. The rest of each
+	 * descriptor is ignored by the hardware, and it is used to build the
+	 * new descriptor afterwards.
+	 */
+	va = base_va;
+	for (pages_left = pages_count; pages_left > 0U; pages_left -= run) {
+		entry = find_xlat_table_entry_run(ctx, va, pages_left, &run);
+		assert(entry != NULL);
 
-		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
-		 */
+		for (size_t i = 0U; i < run; i++)
+			entry[i] &= ~(uint64_t)VALID_DESC;
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+		xlat_arch_clean_dcache_range((uintptr_t)entry,
+					     run * sizeof(uint64_t));
+#endif
+		va += run * PAGE_SIZE;
+	}
 
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+	/* Invalidate any cached copy of the range in the TLBs. */
+	xlat_arch_tlbi_va_range(base_va, size, ctx->xlat_regime);
 
-		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
-		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+	/* Ensure completion of the invalidation. */
+	xlat_arch_tlbi_va_sync();
 
-		/*
-		 * The break-before-make sequence requires writing an invalid
-		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
-		 */
-		*entry = INVALID_DESC;
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		dccvac((uintptr_t)entry);
-#endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+	va = base_va;
+	for (pages_left = pages_count; pages_left > 0U; pages_left -= run) {
+		entry = find_xlat_table_entry_run(ctx, va, pages_left, &run);
+		assert(entry != NULL);
 
-		/* Ensure completion of the invalidation. */
-		xlat_arch_tlbi_va_sync();
+		for (size_t i = 0U; i < run; i++) {
+			uint64_t desc = entry[i] | PAGE_DESC;
+			uint32_t new_attr;
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+			/*
+			 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER
+			 * and MT_USER/MT_PRIVILEGED are taken into account. Any
+			 * other information is ignored.
+			 */
+			new_attr = xlat_desc_get_attributes(ctx, desc) &
+				   ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+			new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			/* Write new descriptor */
+			entry[i] = xlat_desc(ctx, new_attr,
+					     desc & TABLE_ADDR_MASK,
+					     XLAT_TABLE_LEVEL_MAX);
+		}
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		dccvac((uintptr_t)entry);
+		xlat_arch_clean_dcache_range((uintptr_t)entry,
+					     run * sizeof(uint64_t));
 #endif
-		base_va += PAGE_SIZE;
+		va += run * PAGE_SIZE;
 	}
 
 	/* Ensure that the last descriptor writen is seen by the system. */
-	dsbish();
+	xlat_arch_tables_sync();
 
 	return 0;
 }
@@ -18,26 +18,33 @@
  */
 #define ZALLOC_ALIGNMENT	sizeof(void *)
 
-static uintptr_t zalloc_start;
-static uintptr_t zalloc_end;
-static uintptr_t zalloc_current;
+/*
+ * The allocator state is kept per call, so that several images can be
+ * decompressed at the same time on different cores.
+ */
+struct zalloc_state {
+	uintptr_t start;
+	uintptr_t end;
+	uintptr_t current;
+};
 
 static void * ZLIB_INTERNAL zcalloc(void *opaque, unsigned int items,
 				    unsigned int size)
 {
+	struct zalloc_state *zalloc = opaque;
 	uintptr_t p, p_end;
 
 	size *= items;
 
-	p = round_up(zalloc_current, ZALLOC_ALIGNMENT);
+	p = round_up(zalloc->current, ZALLOC_ALIGNMENT);
 	p_end = p + size;
 
-	if (p_end > zalloc_end)
+	if (p_end > zalloc->end)
 		return NULL;
 
 	memset((void *)p, 0, size);
 
-	zalloc_current = p_end;
+	zalloc->current = p_end;
 
 	return (void *)p;
 }
@@ -58,12 +65,13 @@ static void ZLIB_INTERNAL zfree(void *opaque, void *ptr)
 int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len)
 {
+	struct zalloc_state zalloc;
 	z_stream stream;
 	int zret, ret;
 
-	zalloc_start = work_buf;
-	zalloc_end = work_buf + work_len;
-	zalloc_current = zalloc_start;
+	zalloc.start = work_buf;
+	zalloc.end = work_buf + work_len;
+	zalloc.current = zalloc.start;
 
 	stream.next_in = (typeof(stream.next_in))*in_buf;
 	stream.avail_in = in_len;
@@ -71,7 +79,7 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	stream.avail_out = out_len;
 	stream.zalloc = zcalloc;
 	stream.zfree = zfree;
-	stream.opaque = (voidpf)0;
+	stream.opaque = (voidpf)&zalloc;
 
 	zret = inflateInit(&stream);
 	if (zret != Z_OK) {
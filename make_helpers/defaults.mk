@@ -23,6 +23,10 @@ ARCH				:= aarch64
 ARM_ARCH_MAJOR			:= 8
 ARM_ARCH_MINOR			:= 0
 
+# Authenticate images that are only verified by hash while they are being
+# loaded, instead of in a second pass after loading them.
+AUTH_STREAM_HASH		:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -33,6 +37,10 @@ BL2_AT_EL3			:= 0
 # when BL2_AT_EL3 is 1.
 BL2_IN_XIP_MEM			:= 0
 
+# Release the secondary cores in BL2 to run work deferred while loading images,
+# e.g. image decompression.
+BL2_PARALLEL_WORK		:= 0
+
 # By default, consider that the platform may release several CPUs out of reset.
 # The platform Makefile is free to override this value.
 COLD_BOOT_SINGLE_CPU		:= 0
@@ -51,6 +59,10 @@ CTX_INCLUDE_AARCH32_REGS	:= 1
 # Include FP registers in cpu context
 CTX_INCLUDE_FPREGS		:= 0
 
+# Only write the EL1 system registers that differ between the two worlds when
+# dispatchers switch the CPU context
+CTX_LAZY_EL1_SYSREGS		:= 0
+
 # Debug build
 DEBUG				:= 0
 
@@ -61,6 +73,9 @@ DEFAULT_PLAT			:= fvp
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to record the time spent in the cold boot stages and image loading
+ENABLE_BOOT_TIMELINE		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -70,9 +85,24 @@ ENABLE_PMF			:= 0
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
+# Flag to enable the histograms of the PSCI idle state residencies and latencies
+ENABLE_PSCI_STAT_HIST		:= 0
+
+# Flag to enable counting the calls dispatched through function ID tables
+ENABLE_RT_SVC_FID_STATS		:= 0
+
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to enable the statistics of SMCs and interrupts handled by BL31
+ENABLE_RUNTIME_STATS		:= 0
+
+# Flag to enable the dispatch latency statistics of SDEI events
+ENABLE_SDEI_STATS		:= 0
+
+# Flag to enable the SMC benchmark runtime service
+ENABLE_SMC_BENCHMARK		:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -109,9 +139,21 @@ HANDLE_EA_EL3_FIRST		:= 0
 # operations.
 HW_ASSISTED_COHERENCY		:= 0
 
+# Keep the IO device connections used to load images open until the boot
+# stage hands off, instead of closing them after each image.
+KEEP_IO_DEV_OPEN		:= 0
+
 # Set the default algorithm for the generation of Trusted Board Boot keys
 KEY_ALG				:= rsa
 
+# Use the FP/SIMD registers in the AArch64 memcpy() and memset() of the bundled
+# libc for large buffers. Requires LIBC_WORD_MEM_OPS.
+LIBC_NEON_MEM_OPS		:= 0
+
+# Use word-at-a-time implementations of memcpy(), memmove(), memset() and
+# memcmp() in the bundled libc instead of the byte loops.
+LIBC_WORD_MEM_OPS		:= 0
+
 # Enable use of the console API allowing multiple consoles to be registered
 # at the same time.
 MULTI_CONSOLE_API		:= 0
@@ -130,6 +172,10 @@ PROGRAMMABLE_RESET_ADDRESS	:= 0
 # Original format.
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Let a CPU suspend without taking the PSCI power domain locks when other CPUs
+# of its cluster are running. Only applicable with HW_ASSISTED_COHERENCY.
+PSCI_LOCKLESS_COORDINATION	:= 0
+
 # Enable RAS support
 RAS_EXTENSION			:= 0
 
@@ -142,6 +188,9 @@ SAVE_KEYS			:= 0
 # Software Delegated Exception support
 SDEI_SUPPORT            	:= 0
 
+# Flag to enable the batched dispatch of SDEI events
+SDEI_BATCH_DISPATCH		:= 0
+
 # Whether code and read-only data should be put on separate memory pages. The
 # platform Makefile is free to override this value.
 SEPARATE_CODE_AND_RODATA	:= 0
@@ -171,6 +220,10 @@ USE_ROMLIB			:= 0
 # Use tbbr_oid.h instead of platform_oid.h
 USE_TBBR_DEFS			:= 1
 
+# Build option to use ticket locks instead of spin locks for PSCI power domain
+# locks. Only applicable with HW_ASSISTED_COHERENCY.
+USE_TICKET_LOCKS		:= 0
+
 # Build verbosity
 V				:= 0
 
@@ -180,6 +233,10 @@ V				:= 0
 # platforms).
 WARMBOOT_ENABLE_DCACHE_EARLY	:= 0
 
+# Whether the translation tables library coalesces subtables into block
+# descriptors and sets the contiguous hint where possible.
+XLAT_TABLES_COALESCE		:= 0
+
 # Build option to enable/disable the Statistical Profiling Extensions
 ENABLE_SPE_FOR_LOWER_ELS	:= 1
 
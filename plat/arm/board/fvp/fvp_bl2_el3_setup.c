@@ -1,12 +1,22 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <arch_helpers.h>
+#include <arm_config.h>
+#include <mmio.h>
 #include <plat_arm.h>
+#include <platform.h>
+#include <platform_def.h>
+#include "drivers/pwrc/fvp_pwrc.h"
 #include "fvp_private.h"
 
+#if BL2_PARALLEL_WORK && !defined(EL3_PAYLOAD_BASE)
+void plat_secondary_cold_boot_setup(void) __dead2;
+#endif
+
 void bl2_el3_early_platform_setup(u_register_t arg0 __unused,
 				  u_register_t arg1 __unused,
 				  u_register_t arg2 __unused,
@@ -27,3 +37,66 @@ void bl2_el3_early_platform_setup(u_register_t arg0 __unused,
 	 */
 	fvp_interconnect_enable();
 }
+
+/*
+ * With an EL3 payload, the secondary PEs are not powered off but poll the
+ * trusted mailbox for the payload entrypoint, so none is released.
+ */
+#if BL2_PARALLEL_WORK && !defined(EL3_PAYLOAD_BASE)
+/*
+ * Return the MPIDR of PE `thread` of CPU `cpu` in the cluster of `mpidr`.
+ */
+static u_register_t fvp_bl2_pe_mpidr(u_register_t mpidr, unsigned int cpu,
+				     unsigned int thread)
+{
+	if ((arm_config.flags & ARM_CONFIG_FVP_SHIFTED_AFF) != 0U) {
+		return (mpidr & (MPIDR_AFFLVL_MASK << MPIDR_AFF2_SHIFT)) |
+		       ((u_register_t)cpu << MPIDR_AFF1_SHIFT) | thread;
+	}
+
+	return (mpidr & MPIDR_CLUSTER_MASK) | cpu;
+}
+
+/*
+ * Release the other PEs of the primary cluster into BL2 work. They were
+ * powered off by plat_secondary_cold_boot_setup() and are powered on with the
+ * entrypoint in the trusted mailbox, so that the warm boot path of
+ * bl2_el3_entrypoint jumps to it. The PEs of the other clusters are left off
+ * as only the primary cluster is coherent in the interconnect at this point.
+ */
+unsigned int plat_bl2_wake_secondaries(uintptr_t entrypoint)
+{
+	u_register_t my_mpidr = read_mpidr_el1() & MPIDR_AFFINITY_MASK;
+	u_register_t mpidr;
+	unsigned int cpu, thread, threads, count = 0U;
+
+	threads = ((arm_config.flags & ARM_CONFIG_FVP_SHIFTED_AFF) != 0U) ?
+		  FVP_MAX_PE_PER_CPU : 1U;
+
+	mmio_write_64(PLAT_ARM_TRUSTED_MAILBOX_BASE, entrypoint);
+	dsbsy();
+
+	for (cpu = 0U; cpu < FVP_MAX_CPUS_PER_CLUSTER; cpu++) {
+		for (thread = 0U; thread < threads; thread++) {
+			mpidr = fvp_bl2_pe_mpidr(my_mpidr, cpu, thread);
+			if ((mpidr == my_mpidr) ||
+			    (fvp_pwrc_read_psysr(mpidr) == PSYSR_INVALID))
+				continue;
+
+			fvp_pwrc_write_pponr(mpidr);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/*
+ * Power the PE off again, as after a cold boot. BL31 later powers it on
+ * through PSCI with its own entrypoint in the trusted mailbox.
+ */
+void __dead2 plat_bl2_park_secondary(void)
+{
+	plat_secondary_cold_boot_setup();
+}
+#endif /* BL2_PARALLEL_WORK && !defined(EL3_PAYLOAD_BASE) */
@@ -137,6 +137,9 @@ BL2_SOURCES		+=	plat/arm/board/fvp/${ARCH}/fvp_helpers.S	\
 				plat/arm/board/fvp/fvp_bl2_el3_setup.c		\
 				${FVP_CPU_LIBS}					\
 				${FVP_INTERCONNECT_SOURCES}
+ifeq (${BL2_PARALLEL_WORK},1)
+BL2_SOURCES		+=	plat/arm/board/fvp/drivers/pwrc/fvp_pwrc.c
+endif
 endif
 
 ifeq (${FVP_USE_SP804_TIMER},1)
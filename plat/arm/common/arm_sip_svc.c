@@ -8,7 +8,11 @@
 #include <debug.h>
 #include <plat_arm.h>
 #include <pmf.h>
+#include <psci.h>
+#include <psci_stat_hist.h>
+#include <runtime_stats.h>
 #include <runtime_svc.h>
+#include <sdei.h>
 #include <stdint.h>
 #include <uuid.h>
 
@@ -25,10 +29,7 @@ static int arm_sip_setup(void)
 	return 0;
 }
 
-/*
- * This function handles ARM defined SiP Calls
- */
-static uintptr_t arm_sip_handler(unsigned int smc_fid,
+static uintptr_t arm_sip_exe_state_switch(uint32_t smc_fid,
 			u_register_t x1,
 			u_register_t x2,
 			u_register_t x3,
@@ -37,60 +38,137 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 			void *handle,
 			u_register_t flags)
 {
-	int call_count = 0;
+	u_register_t pc;
+
+	/* Allow calls from non-secure only */
+	if (!is_caller_non_secure(flags))
+		SMC_RET1(handle, STATE_SW_E_DENIED);
+
+	/* Validate supplied entry point */
+	pc = (u_register_t) ((x1 << 32) | (uint32_t) x2);
+	if (arm_validate_ns_entrypoint(pc))
+		SMC_RET1(handle, STATE_SW_E_PARAM);
 
 	/*
-	 * Dispatch PMF calls to PMF SMC handler and return its return
-	 * value
+	 * Pointers used in execution state switch are all 32 bits wide
 	 */
-	if (is_pmf_fid(smc_fid)) {
-		return pmf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
-				handle, flags);
-	}
+	return (uintptr_t) arm_execution_state_switch(smc_fid,
+			(uint32_t) x1, (uint32_t) x2, (uint32_t) x3,
+			(uint32_t) x4, handle);
+}
+
+static uintptr_t arm_sip_call_count(uint32_t smc_fid,
+			u_register_t x1,
+			u_register_t x2,
+			u_register_t x3,
+			u_register_t x4,
+			void *cookie,
+			void *handle,
+			u_register_t flags)
+{
+	int call_count = 0;
+
+	/* PMF calls */
+	call_count += PMF_NUM_SMC_CALLS;
 
-	switch (smc_fid) {
-	case ARM_SIP_SVC_EXE_STATE_SWITCH: {
-		u_register_t pc;
+	/* State switch call */
+	call_count += 1;
 
-		/* Allow calls from non-secure only */
-		if (!is_caller_non_secure(flags))
-			SMC_RET1(handle, STATE_SW_E_DENIED);
+#if ENABLE_RUNTIME_STATS
+	/* Runtime statistics call */
+	call_count += 1;
+#endif
 
-		/* Validate supplied entry point */
-		pc = (u_register_t) ((x1 << 32) | (uint32_t) x2);
-		if (arm_validate_ns_entrypoint(pc))
-			SMC_RET1(handle, STATE_SW_E_PARAM);
+#if ENABLE_PSCI_STAT_HIST
+	/* PSCI histogram calls */
+	call_count += 2;
+#endif
 
-		/*
-		 * Pointers used in execution state switch are all 32 bits wide
-		 */
-		return (uintptr_t) arm_execution_state_switch(smc_fid,
-				(uint32_t) x1, (uint32_t) x2, (uint32_t) x3,
-				(uint32_t) x4, handle);
-		}
+	/* Multiple CPU power on call */
+	call_count += 1;
 
-	case ARM_SIP_SVC_CALL_COUNT:
-		/* PMF calls */
-		call_count += PMF_NUM_SMC_CALLS;
+#if ENABLE_SDEI_STATS
+	/* SDEI statistics call */
+	call_count += 1;
+#endif
 
-		/* State switch call */
-		call_count += 1;
+	SMC_RET1(handle, call_count);
+}
+
+static uintptr_t arm_sip_uid(uint32_t smc_fid,
+			u_register_t x1,
+			u_register_t x2,
+			u_register_t x3,
+			u_register_t x4,
+			void *cookie,
+			void *handle,
+			u_register_t flags)
+{
+	/* Return UID to the caller */
+	SMC_UUID_RET(handle, arm_sip_svc_uid);
+}
 
-		SMC_RET1(handle, call_count);
+static uintptr_t arm_sip_version(uint32_t smc_fid,
+			u_register_t x1,
+			u_register_t x2,
+			u_register_t x3,
+			u_register_t x4,
+			void *cookie,
+			void *handle,
+			u_register_t flags)
+{
+	/* Return the version of current implementation */
+	SMC_RET2(handle, ARM_SIP_SVC_VERSION_MAJOR, ARM_SIP_SVC_VERSION_MINOR);
+}
 
-	case ARM_SIP_SVC_UID:
-		/* Return UID to the caller */
-		SMC_UUID_RET(handle, arm_sip_svc_uid);
+/* ARM defined SiP Calls, sorted by function ID */
+static const rt_svc_fid_t arm_sip_fids[] = {
+	{ PMF_SMC_GET_TIMESTAMP_32,	pmf_smc_handler },
+	{ ARM_SIP_SVC_EXE_STATE_SWITCH,	arm_sip_exe_state_switch },
+	{ ARM_SIP_SVC_CALL_COUNT,	arm_sip_call_count },
+	{ ARM_SIP_SVC_UID,		arm_sip_uid },
+	{ ARM_SIP_SVC_VERSION,		arm_sip_version },
+	{ PMF_SMC_GET_TIMESTAMP_64,	pmf_smc_handler },
+#if ENABLE_RUNTIME_STATS
+	{ RUNTIME_STATS_SMC_GET_64,	runtime_stats_smc_handler },
+#endif
+#if ENABLE_PSCI_STAT_HIST
+	{ PSCI_STAT_HIST_GET_64,	psci_stat_hist_smc_handler },
+	{ PSCI_STAT_HIST_RESET_64,	psci_stat_hist_smc_handler },
+#endif
+	{ PSCI_CPU_ON_MULTI_64,		psci_cpu_on_multi_smc_handler },
+#if ENABLE_SDEI_STATS
+	{ SDEI_STATS_GET_64,		sdei_stats_smc_handler },
+#endif
+#if ENABLE_RUNTIME_STATS
+	{ RUNTIME_STATS_HIST_GET_64,	runtime_stats_smc_handler },
+#endif
+};
+
+DECLARE_RT_SVC_FIDS(arm_sip_svc_fids, arm_sip_fids);
 
-	case ARM_SIP_SVC_VERSION:
-		/* Return the version of current implementation */
-		SMC_RET2(handle, ARM_SIP_SVC_VERSION_MAJOR, ARM_SIP_SVC_VERSION_MINOR);
+/*
+ * This function handles ARM defined SiP Calls
+ */
+static uintptr_t arm_sip_handler(unsigned int smc_fid,
+			u_register_t x1,
+			u_register_t x2,
+			u_register_t x3,
+			u_register_t x4,
+			void *cookie,
+			void *handle,
+			u_register_t flags)
+{
+	rt_svc_handle_t fid_handler;
 
-	default:
-		WARN("Unimplemented ARM SiP Service Call: 0x%x \n", smc_fid);
-		SMC_RET1(handle, SMC_UNK);
+	fid_handler = rt_svc_fid_lookup(&arm_sip_svc_fids, smc_fid);
+	if (fid_handler != NULL) {
+		return fid_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
+				   flags);
 	}
 
+	WARN("Unimplemented ARM SiP Service Call: 0x%x \n", smc_fid);
+	SMC_RET1(handle, SMC_UNK);
 }
 
 
@@ -25,6 +25,10 @@
 #pragma weak bl2_plat_handle_post_image_load
 #pragma weak plat_try_next_boot_source
 #pragma weak plat_get_mbedtls_heap
+#if BL2_PARALLEL_WORK
+#pragma weak plat_bl2_wake_secondaries
+#pragma weak plat_bl2_park_secondary
+#endif
 
 void bl2_el3_plat_prepare_exit(void)
 {
@@ -55,6 +59,22 @@ int plat_try_next_boot_source(void)
 	return 0;
 }
 
+#if BL2_PARALLEL_WORK
+/*
+ * By default no secondary core is released, so BL2 work is run by the primary
+ * core while it waits for it to be done.
+ */
+unsigned int plat_bl2_wake_secondaries(uintptr_t entrypoint)
+{
+	return 0;
+}
+
+void __dead2 plat_bl2_park_secondary(void)
+{
+	plat_panic_handler();
+}
+#endif
+
 #if TRUSTED_BOARD_BOOT
 /*
  * The following default implementation of the function simply returns the
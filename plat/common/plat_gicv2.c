@@ -27,6 +27,7 @@
 #pragma weak plat_ic_is_ppi
 #pragma weak plat_ic_is_sgi
 #pragma weak plat_ic_get_interrupt_active
+#pragma weak plat_ic_get_interrupt_pending
 #pragma weak plat_ic_enable_interrupt
 #pragma weak plat_ic_disable_interrupt
 #pragma weak plat_ic_set_interrupt_priority
@@ -173,6 +174,11 @@ unsigned int plat_ic_get_interrupt_active(unsigned int id)
 	return gicv2_get_interrupt_active(id);
 }
 
+unsigned int plat_ic_get_interrupt_pending(unsigned int id)
+{
+	return gicv2_get_interrupt_pending(id);
+}
+
 void plat_ic_enable_interrupt(unsigned int id)
 {
 	gicv2_enable_interrupt(id);
@@ -32,6 +32,7 @@
 #pragma weak plat_ic_is_ppi
 #pragma weak plat_ic_is_sgi
 #pragma weak plat_ic_get_interrupt_active
+#pragma weak plat_ic_get_interrupt_pending
 #pragma weak plat_ic_enable_interrupt
 #pragma weak plat_ic_disable_interrupt
 #pragma weak plat_ic_set_interrupt_priority
@@ -202,6 +203,11 @@ unsigned int plat_ic_get_interrupt_active(unsigned int id)
 	return gicv3_get_interrupt_active(id, plat_my_core_pos());
 }
 
+unsigned int plat_ic_get_interrupt_pending(unsigned int id)
+{
+	return gicv3_get_interrupt_pending(id, plat_my_core_pos());
+}
+
 void plat_ic_enable_interrupt(unsigned int id)
 {
 	gicv3_enable_interrupt(id, plat_my_core_pos());
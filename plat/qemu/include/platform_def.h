@@ -102,6 +102,9 @@
 #define PLAT_QEMU_HOLD_STATE_WAIT	0
 #define PLAT_QEMU_HOLD_STATE_GO		1
 
+/* Boot timeline, in the upper half of the shared RAM */
+#define PLAT_BOOT_TIMELINE_BASE		(SHARED_RAM_BASE + 0x800)
+
 #define BL_RAM_BASE			(SHARED_RAM_BASE + SHARED_RAM_SIZE)
 #define BL_RAM_SIZE			(SEC_SRAM_SIZE - SHARED_RAM_SIZE)
 
@@ -150,6 +150,10 @@ BL31_SOURCES		+=	lib/cpus/aarch64/aem_generic.S		\
 				plat/qemu/topology.c			\
 				plat/qemu/aarch64/plat_helpers.S	\
 				plat/qemu/qemu_bl31_setup.c
+
+ifneq (${ENABLE_RUNTIME_STATS}${ENABLE_PSCI_STAT_HIST},00)
+BL31_SOURCES		+=	plat/qemu/qemu_sip_svc.c
+endif
 endif
 
 # Add the build options to pack Trusted OS Extra1 and Trusted OS Extra2 images
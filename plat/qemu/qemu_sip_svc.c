@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <debug.h>
+#include <psci_stat_hist.h>
+#include <runtime_stats.h>
+#include <runtime_svc.h>
+#include <stdint.h>
+
+/*
+ * QEMU has no SiP calls of its own. This service only exposes the runtime
+ * statistics of BL31 and the PSCI idle state histograms, and is built with
+ * ENABLE_RUNTIME_STATS or ENABLE_PSCI_STAT_HIST.
+ */
+static const rt_svc_fid_t qemu_sip_fids[] = {
+#if ENABLE_RUNTIME_STATS
+	{ RUNTIME_STATS_SMC_GET_64,	runtime_stats_smc_handler },
+#endif
+#if ENABLE_PSCI_STAT_HIST
+	{ PSCI_STAT_HIST_GET_64,	psci_stat_hist_smc_handler },
+	{ PSCI_STAT_HIST_RESET_64,	psci_stat_hist_smc_handler },
+#endif
+#if ENABLE_RUNTIME_STATS
+	{ RUNTIME_STATS_HIST_GET_64,	runtime_stats_smc_handler },
+#endif
+};
+
+DECLARE_RT_SVC_FIDS(qemu_sip_svc_fids, qemu_sip_fids);
+
+static uintptr_t qemu_sip_handler(uint32_t smc_fid,
+				  u_register_t x1,
+				  u_register_t x2,
+				  u_register_t x3,
+				  u_register_t x4,
+				  void *cookie,
+				  void *handle,
+				  u_register_t flags)
+{
+	rt_svc_handle_t fid_handler;
+
+	fid_handler = rt_svc_fid_lookup(&qemu_sip_svc_fids, smc_fid);
+	if (fid_handler != NULL) {
+		return fid_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
+				   flags);
+	}
+
+	WARN("Unimplemented QEMU SiP Service Call: 0x%x\n", smc_fid);
+	SMC_RET1(handle, SMC_UNK);
+}
+
+DECLARE_RT_SVC(
+	qemu_sip_svc,
+	OEN_SIP_START,
+	OEN_SIP_END,
+	SMC_TYPE_FAST,
+	NULL,
+	qemu_sip_handler
+);
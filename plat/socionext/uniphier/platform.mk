@@ -101,6 +101,9 @@ $(ROTPK_HASH): $(ROT_KEY)
 endif
 
 ifeq (${FIP_GZIP},1)
+ifeq (${FIP_LZ4},1)
+$(error FIP_GZIP and FIP_LZ4 cannot be enabled at the same time)
+endif
 
 include lib/zlib/zlib.mk
 
@@ -117,6 +120,23 @@ BL33_PRE_TOOL_FILTER	:= GZIP
 
 endif
 
+ifeq (${FIP_LZ4},1)
+
+include lib/lz4/lz4.mk
+
+BL2_SOURCES		+=	common/image_decompress.c		\
+				$(LZ4_SOURCES)
+
+$(eval $(call add_define,UNIPHIER_DECOMPRESS_LZ4))
+
+# compress all images loaded by BL2
+SCP_BL2_PRE_TOOL_FILTER	:= LZ4
+BL31_PRE_TOOL_FILTER	:= LZ4
+BL32_PRE_TOOL_FILTER	:= LZ4
+BL33_PRE_TOOL_FILTER	:= LZ4
+
+endif
+
 .PHONY: bl2_gzip
 bl2_gzip: $(BUILD_PLAT)/bl2.bin.gz
 %.gz: %
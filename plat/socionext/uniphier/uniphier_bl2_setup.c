@@ -15,6 +15,9 @@
 #ifdef UNIPHIER_DECOMPRESS_GZIP
 #include <tf_gunzip.h>
 #endif
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+#include <tf_unlz4.h>
+#endif
 #include <xlat_tables_v2.h>
 
 #include "uniphier.h"
@@ -125,18 +128,45 @@ bl_params_t *plat_get_next_bl_params(void)
 	return get_next_bl_params_from_mem_params_desc();
 }
 
+#if defined(UNIPHIER_DECOMPRESS_GZIP) || defined(UNIPHIER_DECOMPRESS_LZ4)
+#define UNIPHIER_DECOMPRESS
+#endif
+
+/*
+ * With BL2_PARALLEL_WORK, the image buffer is split in two so that an image can
+ * be loaded while the previous one is decompressed.
+ */
+#if BL2_PARALLEL_WORK
+#define UNIPHIER_IMAGE_BUF_COUNT	2
+#else
+#define UNIPHIER_IMAGE_BUF_COUNT	1
+#endif
+
+#define UNIPHIER_IMAGE_BUF_SIZE_EACH	((UNIPHIER_IMAGE_BUF_SIZE) / \
+					 (UNIPHIER_IMAGE_BUF_COUNT))
+
 void bl2_plat_preload_setup(void)
 {
 #ifdef UNIPHIER_DECOMPRESS_GZIP
 	image_decompress_init(UNIPHIER_IMAGE_BUF_BASE,
-			      UNIPHIER_IMAGE_BUF_SIZE,
+			      UNIPHIER_IMAGE_BUF_SIZE_EACH,
 			      gunzip);
 #endif
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+	image_decompress_init(UNIPHIER_IMAGE_BUF_BASE,
+			      UNIPHIER_IMAGE_BUF_SIZE_EACH,
+			      unlz4);
+#endif
+#if defined(UNIPHIER_DECOMPRESS) && BL2_PARALLEL_WORK
+	image_decompress_add_buf(UNIPHIER_IMAGE_BUF_BASE +
+				 UNIPHIER_IMAGE_BUF_SIZE_EACH,
+				 UNIPHIER_IMAGE_BUF_SIZE_EACH);
+#endif
 }
 
 int bl2_plat_handle_pre_image_load(unsigned int image_id)
 {
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	image_decompress_prepare(uniphier_get_image_info(image_id));
 #endif
 	return 0;
@@ -144,7 +174,7 @@ int bl2_plat_handle_pre_image_load(unsigned int image_id)
 
 int bl2_plat_handle_post_image_load(unsigned int image_id)
 {
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	struct image_info *image_info;
 	int ret;
 
@@ -154,6 +184,15 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 		ret = image_decompress(uniphier_get_image_info(image_id));
 		if (ret)
 			return ret;
+
+#if BL2_PARALLEL_WORK
+		/* The SCP firmware must be decompressed before it is started */
+		if (image_id == SCP_BL2_IMAGE_ID && uniphier_bl2_kick_scp) {
+			ret = image_decompress_wait(image_info);
+			if (ret)
+				return ret;
+		}
+#endif
 	}
 #endif
 
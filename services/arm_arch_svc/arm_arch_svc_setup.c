@@ -99,8 +99,11 @@ static uintptr_t arm_arch_svc_smc_handler(uint32_t smc_fid,
 	}
 }
 
-/* Register Standard Service Calls as runtime service */
-DECLARE_RT_SVC(
+/*
+ * Register Arm Architecture Service Calls as runtime service. None of them
+ * needs the complete context of the caller, so they are all leaf calls.
+ */
+DECLARE_RT_SVC_LEAF(
 		arm_arch_svc,
 		OEN_ARM_START,
 		OEN_ARM_END,
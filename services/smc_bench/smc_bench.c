@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <debug.h>
+#include <runtime_svc.h>
+#include <smc_bench.h>
+#include <smccc_helpers.h>
+#include <spinlock.h>
+#include <stdint.h>
+#include <ticket_lock.h>
+
+/*
+ * Locks contended by SMC_BENCH_LOCK_64, and the count they protect. Like the
+ * PSCI power domain locks, they are shared by all CPUs and held for a short
+ * critical section.
+ */
+static spinlock_t bench_spin_lock;
+static ticket_lock_t bench_ticket_lock;
+static unsigned int bench_lock_count;
+
+/*
+ * Take and release the lock selected by `lock`, and return the number of
+ * counter ticks spent waiting for it.
+ */
+static uint64_t smc_bench_lock(u_register_t lock)
+{
+	uint64_t start, ticks;
+
+	start = read_cntpct_el0();
+
+	if (lock == SMC_BENCH_SPIN_LOCK) {
+		spin_lock(&bench_spin_lock);
+		ticks = read_cntpct_el0() - start;
+		bench_lock_count++;
+		spin_unlock(&bench_spin_lock);
+	} else {
+		ticket_lock_get(&bench_ticket_lock);
+		ticks = read_cntpct_el0() - start;
+		bench_lock_count++;
+		ticket_lock_release(&bench_ticket_lock);
+	}
+
+	return ticks;
+}
+
+/*
+ * Calls used to measure the cost of an SMC round trip through the runtime
+ * exception vectors, handle_runtime_svc() and el3_exit. The handlers do as
+ * little as possible so that the measured time is the cost of the SMC
+ * itself. Callers compare the counter values read before and after the SMC
+ * with the value returned by SMC_BENCH_TIMESTAMP_64 to split the round trip
+ * into its entry and exit paths. SMC_BENCH_LOCK_64 instead returns the time
+ * spent waiting for a lock, for callers that issue it on several CPUs at once.
+ */
+static uintptr_t smc_bench_handler(uint32_t smc_fid,
+				   u_register_t x1,
+				   u_register_t x2,
+				   u_register_t x3,
+				   u_register_t x4,
+				   void *cookie,
+				   void *handle,
+				   u_register_t flags)
+{
+	switch (smc_fid) {
+	case SMC_BENCH_NULL_32:
+	case SMC_BENCH_NULL_64:
+		SMC_RET1(handle, SMC_OK);
+
+	case SMC_BENCH_TIMESTAMP_64:
+		SMC_RET2(handle, SMC_OK, read_cntpct_el0());
+
+	case SMC_BENCH_LOCK_64:
+		if ((x1 != SMC_BENCH_SPIN_LOCK) && (x1 != SMC_BENCH_TICKET_LOCK))
+			SMC_RET1(handle, SMC_UNK);
+
+		SMC_RET2(handle, SMC_OK, smc_bench_lock(x1));
+
+	case SMC_BENCH_CALL_COUNT:
+		SMC_RET1(handle, SMC_BENCH_NUM_CALLS);
+
+	case SMC_BENCH_VERSION:
+		SMC_RET2(handle, SMC_BENCH_VERSION_MAJOR,
+			 SMC_BENCH_VERSION_MINOR);
+
+	default:
+		WARN("Unimplemented SMC benchmark call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+
+DECLARE_RT_SVC(
+	smc_bench,
+	OEN_OEM_START,
+	OEN_OEM_END,
+	SMC_TYPE_FAST,
+	NULL,
+	smc_bench_handler
+);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -72,7 +72,7 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 	assert(&optee_ctx->cpu_ctx == cm_get_context(SECURE));
 
 	cm_set_elr_el3(SECURE, (uint64_t)&optee_vector_table->fiq_entry);
-	cm_el1_sysregs_context_restore(SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
 	cm_set_next_eret_context(SECURE);
 
 	/*
@@ -242,7 +242,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 					&optee_vector_table->yield_smc_entry);
 		}
 
-		cm_el1_sysregs_context_restore(SECURE);
+		cm_el1_sysregs_context_restore_lazy(SECURE);
 		cm_set_next_eret_context(SECURE);
 
 		write_ctx_reg(get_gpregs_ctx(&optee_ctx->cpu_ctx),
@@ -367,7 +367,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		assert(ns_cpu_context);
 
 		/* Restore non-secure state */
-		cm_el1_sysregs_context_restore(NON_SECURE);
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
 		SMC_RET4(ns_cpu_context, x1, x2, x3, x4);
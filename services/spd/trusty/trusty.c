@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -112,7 +112,8 @@ static struct args trusty_context_switch(uint32_t security_state, uint64_t r0,
 
 	assert(ctx->saved_security_state == !security_state);
 
-	cm_el1_sysregs_context_restore(security_state);
+	/* The other security state saved its context before switching back */
+	cm_el1_sysregs_context_restore_lazy(security_state);
 	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
 		fpregs_context_restore(get_fpregs_ctx(cm_get_context(security_state)));
 
@@ -318,7 +319,7 @@ static int32_t trusty_init(void)
 
 	trusty_context_switch_helper(&ctx->saved_sp, &zero_args);
 
-	cm_el1_sysregs_context_restore(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
 	cm_set_next_eret_context(NON_SECURE);
 
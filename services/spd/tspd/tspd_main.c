@@ -75,7 +75,7 @@ uint64_t tspd_handle_sp_preemption(void *handle)
 	/*
 	 * Restore non-secure state.
 	 */
-	cm_el1_sysregs_context_restore(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 	cm_set_next_eret_context(NON_SECURE);
 
 	/*
@@ -134,7 +134,7 @@ static uint64_t tspd_sel1_interrupt_handler(uint32_t id,
 #endif
 	}
 
-	cm_el1_sysregs_context_restore(SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
 	cm_set_elr_spsr_el3(SECURE, (uint64_t) &tsp_vectors->sel1_intr_entry,
 		    SPSR_64(MODE_EL1, MODE_SP_ELX, DISABLE_ALL_EXCEPTIONS));
 
@@ -558,7 +558,7 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 #endif
 			}
 
-			cm_el1_sysregs_context_restore(SECURE);
+			cm_el1_sysregs_context_restore_lazy(SECURE);
 			cm_set_next_eret_context(SECURE);
 			SMC_RET3(&tsp_ctx->cpu_ctx, smc_fid, x1, x2);
 		} else {
@@ -576,7 +576,7 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			assert(ns_cpu_context);
 
 			/* Restore non-secure state */
-			cm_el1_sysregs_context_restore(NON_SECURE);
+			cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 			cm_set_next_eret_context(NON_SECURE);
 			if (GET_SMC_TYPE(smc_fid) == SMC_TYPE_YIELD) {
 				clr_yield_smc_active_flag(tsp_ctx->state);
@@ -621,7 +621,8 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			break;
 		}
 
-		cm_el1_sysregs_context_restore(NON_SECURE);
+		/* The secure context was saved when the TSP returned */
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 		SMC_RET1(handle, SMC_OK);
 
@@ -673,7 +674,7 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 		/* We just need to return to the preempted point in
 		 * TSP and the execution will resume as normal.
 		 */
-		cm_el1_sysregs_context_restore(SECURE);
+		cm_el1_sysregs_context_restore_lazy(SECURE);
 		cm_set_next_eret_context(SECURE);
 		SMC_RET0(&tsp_ctx->cpu_ctx);
 
@@ -10,14 +10,26 @@
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/* Interrupt IDs up to the last SPI, as defined by the GIC architecture */
+#define SDEI_INTR_INDEX_SIZE	1020U
+
+/*
+ * Index of the bound mappings by interrupt ID, so that the mapping of an SDEI
+ * interrupt is found in constant time on dispatch. An entry holds the offset
+ * of the mapping in the private mappings for an SGI or PPI, or in the shared
+ * mappings for an SPI, plus one. It is 0 if no mapping is bound.
+ */
+static uint8_t sdei_intr_index[SDEI_INTR_INDEX_SIZE];
+
 /*
- * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
- * entry. On error, returns NULL.
+ * Get SDEI entry with the given mapping, for the CPU with the given linear
+ * index if the event is private: on success, returns pointer to SDEI entry.
+ * On error, returns NULL.
  *
  * Both shared and private maps are stored in single-dimensional array. Private
  * event entries are kept for each PE forming a 2D array.
  */
-sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
+sdei_entry_t *get_cpu_event_entry(sdei_ev_map_t *map, unsigned int cpu_idx)
 {
 	const sdei_mapping_t *mapping;
 	sdei_entry_t *cpu_priv_base;
@@ -25,6 +37,8 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 	long int idx;
 
 	if (is_event_private(map)) {
+		assert(cpu_idx < PLATFORM_CORE_COUNT);
+
 		/*
 		 * For a private map, find the index of the mapping in the
 		 * array.
@@ -32,8 +46,8 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 		mapping = SDEI_PRIVATE_MAPPING();
 		idx = MAP_OFF(map, mapping);
 
-		/* Base of private mappings for this CPU */
-		base_idx = plat_my_core_pos() * ((unsigned int) mapping->num_maps);
+		/* Base of private mappings for the CPU */
+		base_idx = cpu_idx * ((unsigned int) mapping->num_maps);
 		cpu_priv_base = &sdei_private_event_table[base_idx];
 
 		/*
@@ -49,6 +63,37 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 	}
 }
 
+/* Get SDEI entry with the given mapping, for this CPU if the event is private */
+sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
+{
+	return get_cpu_event_entry(map, plat_my_core_pos());
+}
+
+/*
+ * Record the interrupt of a bound mapping in the interrupt index. This must be
+ * called once the interrupt number of the mapping is set.
+ */
+void set_intr_index(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+
+	if ((map->intr == SDEI_DYN_IRQ) || (map->intr >= SDEI_INTR_INDEX_SIZE))
+		return;
+
+	mapping = is_event_private(map) ? SDEI_PRIVATE_MAPPING() :
+		SDEI_SHARED_MAPPING();
+	assert(mapping->num_maps < UINT8_MAX);
+
+	sdei_intr_index[map->intr] = (uint8_t) (MAP_OFF(map, mapping) + 1);
+}
+
+/* Remove an interrupt from the interrupt index, when its mapping is released */
+void clr_intr_index(unsigned int intr_num)
+{
+	if (intr_num < SDEI_INTR_INDEX_SIZE)
+		sdei_intr_index[intr_num] = 0U;
+}
+
 /*
  * Find event mapping for a given interrupt number: On success, returns pointer
  * to the event mapping. On error, returns NULL.
@@ -57,14 +102,29 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 {
 	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i;
+	unsigned int i, idx;
+
+	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 
 	/*
-	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * Bound interrupts are looked up in the interrupt index. The mapping
+	 * is checked against the interrupt number, as the index may be read
+	 * while a mapping is being bound or released.
+	 */
+	if ((intr_num != SDEI_DYN_IRQ) && (intr_num < SDEI_INTR_INDEX_SIZE)) {
+		idx = sdei_intr_index[intr_num];
+		if ((idx == 0U) || (idx > mapping->num_maps))
+			return NULL;
+
+		map = &mapping->map[idx - 1U];
+
+		return (map->intr == intr_num) ? map : NULL;
+	}
+
+	/*
+	 * Look for a free dynamic mapping, or for an interrupt that the index
+	 * doesn't cover. This is a linear search.
 	 */
-	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
 		if (map->intr == intr_num)
 			return map;
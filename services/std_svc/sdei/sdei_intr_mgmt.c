@@ -22,6 +22,12 @@
 /* Maximum preemption nesting levels: Critical priority and Normal priority */
 #define MAX_EVENT_NESTING	2U
 
+#if SDEI_BATCH_DISPATCH
+/* Batched event numbers are passed in x5 onwards, which are saved and restored */
+CASSERT((5U + SDEI_BATCH_MAX_EVENTS) <= SDEI_SAVED_GPREGS,
+		sdei_batch_exceeds_saved_gpregs);
+#endif
+
 /* Per-CPU SDEI state access macro */
 #define sdei_get_this_pe_state()	(&cpu_state[plat_my_core_pos()])
 
@@ -39,6 +45,12 @@ typedef struct sdei_dispatch_context {
 	/* CVE-2018-3639 mitigation state */
 	uint64_t disable_cve_2018_3639;
 #endif
+
+#if SDEI_BATCH_DISPATCH
+	/* Events dispatched along with 'map', and completed with it */
+	sdei_ev_map_t *batch_map[SDEI_BATCH_MAX_EVENTS];
+	unsigned int batch_count;
+#endif
 } sdei_dispatch_context_t;
 
 /* Per-CPU SDEI state data */
@@ -164,6 +176,9 @@ static sdei_dispatch_context_t *save_event_ctx(sdei_ev_map_t *map,
 	disp_ctx = push_dispatch();
 	assert(disp_ctx != NULL);
 	disp_ctx->map = map;
+#if SDEI_BATCH_DISPATCH
+	disp_ctx->batch_count = 0U;
+#endif
 
 	/* Save general purpose and exception registers */
 	memcpy(disp_ctx->x, tgt_gpregs, sizeof(disp_ctx->x));
@@ -279,6 +294,141 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 	disp_ctx->dispatch_jmp = dispatch_jmp;
 }
 
+#if SDEI_BATCH_DISPATCH
+/*
+ * Check whether the event of 'cand' may be dispatched along with the event of
+ * 'map': both must be registered for batched dispatch with the same handler,
+ * and have the same priority.
+ */
+static bool can_batch(sdei_ev_map_t *map, const sdei_entry_t *se,
+		sdei_ev_map_t *cand, const sdei_entry_t *cand_se)
+{
+	return (cand != map) && is_map_bound(cand) && cand_se->batch &&
+		(cand_se->ep == se->ep) &&
+		(is_event_critical(cand) == is_event_critical(map));
+}
+
+/*
+ * Claim an event for a batched dispatch if its interrupt is pending and not
+ * active. The interrupt is not acknowledged; its pending state is cleared
+ * instead, once the event has moved to the running state. A PE that
+ * acknowledges the interrupt meanwhile then finds that the event can't be
+ * dispatched. An interrupt that is active, or whose event can't be dispatched,
+ * is left untouched, so that it's never made pending here.
+ *
+ * Clearing the pending state only claims edge-triggered interrupts: a
+ * level-sensitive interrupt becomes pending again for as long as its source
+ * asserts it, and the event would be dispatched twice.
+ */
+static bool claim_batch_event(sdei_ev_map_t *map, sdei_entry_t *se)
+{
+	bool claimed = false;
+
+	if (is_event_shared(map))
+		sdei_map_lock(map);
+
+	if ((plat_ic_get_interrupt_pending(map->intr) != 0U) &&
+			(plat_ic_get_interrupt_active(map->intr) == 0U) &&
+			can_sdei_state_trans(se, DO_DISPATCH)) {
+		plat_ic_clear_interrupt_pending(map->intr);
+		claimed = true;
+	}
+
+	if (is_event_shared(map))
+		sdei_map_unlock(map);
+
+	return claimed;
+}
+
+/*
+ * Claim the pending events which can be dispatched along with the event being
+ * dispatched, and pass their numbers to the client handler:
+ *
+ * - x4: Number of events dispatched along with the event in x0
+ * - x5 onwards: Their event numbers
+ */
+static void setup_batch_dispatch(sdei_ev_map_t *map, const sdei_entry_t *se,
+		cpu_context_t *ctx)
+{
+	sdei_dispatch_context_t *disp_ctx = get_outstanding_dispatch();
+	uint64_t my_mpidr = read_mpidr_el1() & MPIDR_AFFINITY_MASK;
+	unsigned int i, n = 0U;
+	sdei_ev_map_t *cand;
+	sdei_entry_t *cand_se;
+
+	assert((disp_ctx != NULL) && (disp_ctx->map == map));
+
+	if (!se->batch)
+		return;
+
+	for_each_private_map(i, cand) {
+		if (n == SDEI_BATCH_MAX_EVENTS)
+			break;
+
+		cand_se = get_event_entry(cand);
+		if (can_batch(map, se, cand, cand_se) &&
+				claim_batch_event(cand, cand_se)) {
+			disp_ctx->batch_map[n] = cand;
+			n++;
+		}
+	}
+
+	for_each_shared_map(i, cand) {
+		if (n == SDEI_BATCH_MAX_EVENTS)
+			break;
+
+		/* Skip events routed to another PE */
+		cand_se = get_event_entry(cand);
+		if ((cand_se->reg_flags == SDEI_REGF_RM_PE) &&
+				(cand_se->affinity != my_mpidr))
+			continue;
+
+		if (can_batch(map, se, cand, cand_se) &&
+				claim_batch_event(cand, cand_se)) {
+			disp_ctx->batch_map[n] = cand;
+			n++;
+		}
+	}
+
+	disp_ctx->batch_count = n;
+
+	SMC_SET_GP(ctx, CTX_GPREG_X4, (uint64_t) n);
+	for (i = 0U; i < n; i++) {
+		write_ctx_reg(get_gpregs_ctx(ctx),
+				CTX_GPREG_X5 + (i * sizeof(uint64_t)),
+				(uint64_t) disp_ctx->batch_map[i]->ev_num);
+	}
+
+	if (n != 0U)
+		SDEI_LOG("Batched %u events with ev:%d\n", n, map->ev_num);
+}
+
+/* Complete the events dispatched along with the event being completed */
+static void complete_batch(const sdei_dispatch_context_t *disp_ctx,
+		sdei_action_t act)
+{
+	sdei_ev_map_t *map;
+	sdei_entry_t *se;
+	unsigned int i;
+	bool done __unused;
+
+	for (i = 0U; i < disp_ctx->batch_count; i++) {
+		map = disp_ctx->batch_map[i];
+		se = get_event_entry(map);
+
+		if (is_event_shared(map))
+			sdei_map_lock(map);
+
+		/* The event has been running since it was claimed */
+		done = can_sdei_state_trans(se, act);
+		assert(done);
+
+		if (is_event_shared(map))
+			sdei_map_unlock(map);
+	}
+}
+#endif
+
 /* Handle a triggered SDEI interrupt while events were masked on this PE */
 static void handle_masked_trigger(sdei_ev_map_t *map, sdei_entry_t *se,
 		sdei_cpu_state_t *state, unsigned int intr_raw)
@@ -334,10 +484,37 @@ static void handle_masked_trigger(sdei_ev_map_t *map, sdei_entry_t *se,
 	plat_ic_end_of_interrupt(intr_raw);
 }
 
+#if ENABLE_SDEI_STATS
+/*
+ * Account for the dispatch of an event from its interrupt, which the SDEI
+ * interrupt handler started to handle at time `start`.
+ */
+static void sdei_stats_update(sdei_ev_map_t *map, sdei_entry_t *se,
+		uint64_t start)
+{
+	uint64_t ticks = read_cntpct_el0() - start;
+
+	if (is_event_shared(map))
+		sdei_map_lock(map);
+
+	se->dispatch_count++;
+	se->dispatch_ticks += ticks;
+	if (ticks > se->dispatch_max_ticks)
+		se->dispatch_max_ticks = ticks;
+
+	if (is_event_shared(map))
+		sdei_map_unlock(map);
+}
+#endif
+
 /* SDEI main interrupt handler */
 int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 		void *cookie)
 {
+#if ENABLE_SDEI_STATS
+	/* The interrupt has just been acknowledged by EHF */
+	const uint64_t start = read_cntpct_el0();
+#endif
 	sdei_entry_t *se;
 	cpu_context_t *ctx;
 	sdei_ev_map_t *map;
@@ -480,6 +657,12 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 
 	/* Synchronously dispatch event */
 	setup_ns_dispatch(map, se, ctx, &dispatch_jmp);
+#if SDEI_BATCH_DISPATCH
+	setup_batch_dispatch(map, se, ctx);
+#endif
+#if ENABLE_SDEI_STATS
+	sdei_stats_update(map, se, start);
+#endif
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
@@ -634,6 +817,10 @@ int sdei_event_complete(bool resume, uint64_t pc)
 	if (is_event_shared(map))
 		sdei_map_unlock(map);
 
+#if SDEI_BATCH_DISPATCH
+	complete_batch(disp_ctx, act);
+#endif
+
 	/* Having done sanity checks, pop dispatch */
 	(void) pop_dispatch();
 
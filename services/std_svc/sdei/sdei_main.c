@@ -17,6 +17,7 @@
 #include <pubsub.h>
 #include <runtime_svc.h>
 #include <sdei.h>
+#include <smccc_helpers.h>
 #include <stddef.h>
 #include <string.h>
 #include <utils.h>
@@ -57,6 +58,9 @@ static void clear_event_entries(sdei_entry_t *se)
 	se->arg = 0;
 	se->affinity = 0;
 	se->reg_flags = 0;
+#if SDEI_BATCH_DISPATCH
+	se->batch = false;
+#endif
 }
 
 /* Perform CPU-specific state initialisation */
@@ -138,6 +142,7 @@ static void sdei_class_init(sdei_class_t class)
 			/* Shared mappings must be bound to shared interrupt */
 			assert(plat_ic_is_spi(map->intr) != 0);
 			set_map_bound(map);
+			set_intr_index(map);
 		}
 
 		init_map(map);
@@ -209,7 +214,11 @@ static void sdei_class_init(sdei_class_t class)
 				 */
 				assert(plat_ic_is_ppi((unsigned) map->intr) != 0);
 				set_map_bound(map);
+				set_intr_index(map);
 			}
+		} else {
+			/* Event 0 is dispatched by its SGI */
+			set_intr_index(map);
 		}
 
 		init_map(map);
@@ -334,12 +343,21 @@ static int64_t sdei_event_register(int ev_num, uint64_t ep, uint64_t arg,
 	sdei_entry_t *se;
 	sdei_ev_map_t *map;
 	sdei_state_t backup_state;
+#if SDEI_BATCH_DISPATCH
+	bool batch;
+#endif
 
 	if ((ep == 0U) || (plat_sdei_validate_entry_point(
 					ep, sdei_client_el()) != 0)) {
 		return SDEI_EINVAL;
 	}
 
+#if SDEI_BATCH_DISPATCH
+	/* The batched dispatch request is kept apart from the routing mode */
+	batch = ((flags & SDEI_REGF_BATCH) != 0U);
+	flags &= ~SDEI_REGF_BATCH;
+#endif
+
 	ret = validate_flags(flags, mpidr);
 	if (ret != 0)
 		return ret;
@@ -427,6 +445,9 @@ static int64_t sdei_event_register(int ev_num, uint64_t ep, uint64_t arg,
 
 	/* Populate event entries */
 	set_sdei_entry(se, ep, arg, (unsigned int) flags, mpidr);
+#if SDEI_BATCH_DISPATCH
+	se->batch = batch;
+#endif
 
 	/* Increment register count */
 	map->reg_count++;
@@ -743,6 +764,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			set_intr_index(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -800,6 +822,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		clr_intr_index(map->intr);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
@@ -814,6 +837,46 @@ finish:
 	return ret;
 }
 
+#if ENABLE_SDEI_STATS
+/*
+ * Handle SDEI_STATS_GET_64. The caller gives the event number in x1 and, for a
+ * private event, the MPIDR of the CPU in x2. It gets back the number of
+ * dispatches of the event from its interrupt in x1, the total latency in x2
+ * and the longest latency in x3, both in system counter ticks.
+ */
+uintptr_t sdei_stats_smc_handler(uint32_t smc_fid,
+				 u_register_t x1,
+				 u_register_t x2,
+				 u_register_t x3,
+				 u_register_t x4,
+				 void *cookie,
+				 void *handle,
+				 u_register_t flags)
+{
+	const sdei_entry_t *se;
+	sdei_ev_map_t *map;
+	int cpu = 0;
+
+	if (smc_fid != SDEI_STATS_GET_64)
+		SMC_RET1(handle, SMC_UNK);
+
+	map = find_event_map((int) x1);
+	if (map == NULL)
+		SMC_RET1(handle, -EINVAL);
+
+	if (is_event_private(map)) {
+		cpu = plat_core_pos_by_mpidr(x2);
+		if (cpu < 0)
+			SMC_RET1(handle, -EINVAL);
+	}
+
+	se = get_cpu_event_entry(map, (unsigned int) cpu);
+
+	SMC_RET4(handle, SMC_OK, se->dispatch_count, se->dispatch_ticks,
+			se->dispatch_max_ticks);
+}
+#endif
+
 /* Perform reset of private SDEI events */
 static int sdei_private_reset(void)
 {
@@ -920,6 +983,11 @@ static uint64_t sdei_features(unsigned int feature)
 				num_dyn_shrd_slots);
 	}
 
+#if SDEI_BATCH_DISPATCH
+	if (feature == SDEI_FEATURE_BATCH_DISPATCH)
+		return SDEI_BATCH_MAX_EVENTS;
+#endif
+
 	return (uint64_t) SDEI_EINVAL;
 }
 
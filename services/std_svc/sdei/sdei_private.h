@@ -228,8 +228,11 @@ extern sdei_entry_t sdei_shared_event_table[];
 
 void init_sdei_state(void);
 
+void set_intr_index(sdei_ev_map_t *map);
+void clr_intr_index(unsigned int intr_num);
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared);
 sdei_ev_map_t *find_event_map(int ev_num);
+sdei_entry_t *get_cpu_event_entry(sdei_ev_map_t *map, unsigned int cpu_idx);
 sdei_entry_t *get_event_entry(sdei_ev_map_t *map);
 
 int64_t sdei_event_context(void *handle, unsigned int param);
@@ -9,6 +9,7 @@
 #include <debug.h>
 #include <pmf.h>
 #include <psci.h>
+#include <psci_stat_hist.h>
 #include <runtime_instr.h>
 #include <runtime_svc.h>
 #include <sdei.h>
@@ -97,6 +98,10 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
 		    RT_INSTR_EXIT_PSCI,
 		    PMF_NO_CACHE_MAINT);
+
+#if ENABLE_PSCI_STAT_HIST
+		psci_stats_update_latency();
+#endif
 #endif
 
 		SMC_RET1(handle, ret);
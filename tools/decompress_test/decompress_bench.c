@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Checks and measures the decompressors used by image_decompress() on the
+ * host. Each compressed file is decompressed with gunzip() or unlz4(),
+ * depending on its magic number, and the output is compared with the original
+ * data. The time of each decompression is then measured over a number of
+ * iterations.
+ *
+ * Usage: decompress_bench iterations original compressed...
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <tf_gunzip.h>
+#include <tf_unlz4.h>
+
+#define GZIP_MAGIC		0x8b1fU
+#define LZ4_FRAME_MAGIC		0x184D2204U
+#define LZ4_LEGACY_MAGIC	0x184C2102U
+
+/* Workspace of gunzip(), enough for the inflate state and its window */
+#define WORK_SIZE		(256U * 1024U)
+
+/* Extra space after the expected output, to catch overruns */
+#define OUT_SLACK		4096U
+
+typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
+			     uintptr_t *out_buf, size_t out_len,
+			     uintptr_t work_buf, size_t work_len);
+
+static uint8_t work_buf[WORK_SIZE];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint8_t *read_file(const char *name, size_t *size)
+{
+	FILE *f = fopen(name, "rb");
+	uint8_t *buf;
+	long len;
+
+	if (f == NULL) {
+		perror(name);
+		exit(EXIT_FAILURE);
+	}
+
+	if ((fseek(f, 0, SEEK_END) != 0) || ((len = ftell(f)) < 0) ||
+	    (fseek(f, 0, SEEK_SET) != 0)) {
+		perror(name);
+		exit(EXIT_FAILURE);
+	}
+
+	buf = malloc((size_t)len + 1U);
+	if ((buf == NULL) || (fread(buf, 1, (size_t)len, f) != (size_t)len)) {
+		fprintf(stderr, "%s: cannot read\n", name);
+		exit(EXIT_FAILURE);
+	}
+
+	(void)fclose(f);
+	*size = (size_t)len;
+
+	return buf;
+}
+
+static uint32_t read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * Decompress `in` once into `out` and check that the whole input is consumed
+ * and that the output matches `orig`. Returns 0 on success.
+ */
+static int check(const char *name, decompressor_t *decompressor,
+		 const uint8_t *in, size_t in_len, uint8_t *out,
+		 const uint8_t *orig, size_t orig_len)
+{
+	uintptr_t in_buf = (uintptr_t)in;
+	uintptr_t out_buf = (uintptr_t)out;
+	int ret;
+
+	memset(out, 0xa5, orig_len + OUT_SLACK);
+
+	ret = decompressor(&in_buf, in_len, &out_buf, orig_len + OUT_SLACK,
+			   (uintptr_t)work_buf, sizeof(work_buf));
+	if (ret != 0) {
+		fprintf(stderr, "%s: decompression failed (%d)\n", name, ret);
+		return -1;
+	}
+
+	if (in_buf != (uintptr_t)in + in_len) {
+		fprintf(stderr, "%s: %lu of %zu input bytes consumed\n", name,
+			(unsigned long)(in_buf - (uintptr_t)in), in_len);
+		return -1;
+	}
+
+	if ((out_buf - (uintptr_t)out != orig_len) ||
+	    (memcmp(out, orig, orig_len) != 0)) {
+		fprintf(stderr, "%s: output differs from the original\n", name);
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const uint8_t *orig;
+	size_t orig_len;
+	uint8_t *out;
+	unsigned long iterations;
+	int failures = 0;
+
+	if (argc < 4) {
+		fprintf(stderr,
+			"usage: %s iterations original compressed...\n",
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	iterations = strtoul(argv[1], NULL, 0);
+	if (iterations == 0U)
+		iterations = 1U;
+
+	orig = read_file(argv[2], &orig_len);
+	out = malloc(orig_len + OUT_SLACK);
+	if (out == NULL)
+		return EXIT_FAILURE;
+
+	printf("%-24s %-10s %9s %9s %10s %8s\n", "file", "format", "in (KB)",
+	       "out (KB)", "time (us)", "MB/s");
+
+	for (int i = 3; i < argc; i++) {
+		decompressor_t *decompressor;
+		const char *format;
+		uint8_t *in;
+		size_t in_len;
+		uint64_t start, elapsed;
+
+		in = read_file(argv[i], &in_len);
+
+		if ((in_len >= 2U) && ((in[0] | (in[1] << 8)) == GZIP_MAGIC)) {
+			decompressor = gunzip;
+			format = "gzip";
+		} else if ((in_len >= 4U) &&
+			   (read_le32(in) == LZ4_FRAME_MAGIC)) {
+			decompressor = unlz4;
+			format = "lz4";
+		} else if ((in_len >= 4U) &&
+			   (read_le32(in) == LZ4_LEGACY_MAGIC)) {
+			decompressor = unlz4;
+			format = "lz4 legacy";
+		} else {
+			fprintf(stderr, "%s: unknown format\n", argv[i]);
+			failures++;
+			free(in);
+			continue;
+		}
+
+		if (check(argv[i], decompressor, in, in_len, out, orig,
+			  orig_len) != 0) {
+			failures++;
+			free(in);
+			continue;
+		}
+
+		start = now_ns();
+		for (unsigned long n = 0U; n < iterations; n++) {
+			uintptr_t in_buf = (uintptr_t)in;
+			uintptr_t out_buf = (uintptr_t)out;
+
+			(void)decompressor(&in_buf, in_len, &out_buf,
+					   orig_len + OUT_SLACK,
+					   (uintptr_t)work_buf,
+					   sizeof(work_buf));
+		}
+		elapsed = (now_ns() - start) / iterations;
+		if (elapsed == 0U)
+			elapsed = 1U;
+
+		printf("%-24s %-10s %9zu %9zu %10llu %8.0f\n", argv[i], format,
+		       in_len / 1024U, orig_len / 1024U,
+		       (unsigned long long)(elapsed / 1000U),
+		       ((double)orig_len * 1000.0) / (double)elapsed);
+
+		free(in);
+	}
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* Only errors and warnings are printed, skipping the LOG_MARKER_* prefix. */
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	if ((unsigned int)fmt[0] > 30U)
+		return;
+
+	va_start(args, fmt);
+	(void)vfprintf(stderr, fmt + 1, args);
+	va_end(args);
+}
+
+void do_panic(void)
+{
+	fprintf(stderr, "PANIC\n");
+	abort();
+}
+
+/* Signature used with ENABLE_ASSERTIONS=1 and LOG_LEVEL=40 */
+void __assert(const char *file, unsigned int line)
+{
+	fprintf(stderr, "ASSERT: %s:%u\n", file, line);
+	abort();
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/*
+ * Platform definitions needed to build the decompressors on the host. None is
+ * used by them, this file only satisfies the includes of the libc headers.
+ */
+
+#endif /* PLATFORM_DEF_H */
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the throughput of the variants of memcpy(), memmove(), memset() and
+ * memcmp() of the bundled libc for several sizes and alignments, and checks
+ * their results against the C library of the host. memmove() is measured with
+ * overlapping buffers where the destination is above the source, as the other
+ * case is handled by memcpy(). memcmp() is measured with equal buffers, so
+ * that the whole length is compared.
+ *
+ * Usage: mem_bench [megabytes per measurement]
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SIZE		65536U
+#define BENCH_MOVE_DISTANCE	64U
+
+#define DECLARE_VARIANT(_v)						\
+	void *_v##_memcpy(void *dst, const void *src, size_t len);	\
+	void *_v##_memmove(void *dst, const void *src, size_t len);	\
+	void *_v##_memset(void *dst, int val, size_t len);		\
+	int _v##_memcmp(const void *s1, const void *s2, size_t len)
+
+DECLARE_VARIANT(byte);
+DECLARE_VARIANT(word);
+#if BENCH_AARCH64_ASM
+DECLARE_VARIANT(ldp);
+DECLARE_VARIANT(neon);
+#endif
+
+typedef struct variant {
+	const char *name;
+	void *(*memcpy)(void *dst, const void *src, size_t len);
+	void *(*memmove)(void *dst, const void *src, size_t len);
+	void *(*memset)(void *dst, int val, size_t len);
+	int (*memcmp)(const void *s1, const void *s2, size_t len);
+} variant_t;
+
+#define VARIANT(_v)	{ #_v, _v##_memcpy, _v##_memmove, _v##_memset,	\
+			  _v##_memcmp }
+
+static const variant_t variants[] = {
+	VARIANT(byte),
+	VARIANT(word),
+#if BENCH_AARCH64_ASM
+	VARIANT(ldp),
+	VARIANT(neon),
+#endif
+};
+
+#define NUM_VARIANTS	(sizeof(variants) / sizeof(variants[0]))
+
+typedef enum { OP_MEMCPY, OP_MEMMOVE, OP_MEMSET, OP_MEMCMP } op_t;
+
+static const char *const op_names[] = {
+	"memcpy", "memmove", "memset", "memcmp"
+};
+
+static const size_t sizes[] = { 8, 32, 128, 512, 4096, BENCH_MAX_SIZE };
+
+/* Offsets of the destination and of the source from a 64-byte boundary. */
+/*
+ * For memmove(), the destination is BENCH_MOVE_DISTANCE bytes further, in the
+ * same buffer as the source.
+ */
+static const struct {
+	size_t dst;
+	size_t src;
+} aligns[] = { { 0, 0 }, { 3, 3 }, { 1, 0 } };
+
+static unsigned char src_buf[BENCH_MAX_SIZE + 128] __attribute__((aligned(64)));
+static unsigned char dst_buf[BENCH_MAX_SIZE + 128] __attribute__((aligned(64)));
+static unsigned char ref_buf[BENCH_MAX_SIZE + 128] __attribute__((aligned(64)));
+
+/* Keeps the compiler from dropping the memcmp() calls. */
+static volatile int sink;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void fill(unsigned char *buf, size_t len, unsigned int seed)
+{
+	for (size_t i = 0; i < len; i++)
+		buf[i] = (unsigned char)((i * 7U) + seed);
+}
+
+static void run(const variant_t *v, op_t op, unsigned char *dst,
+		unsigned char *src, size_t len)
+{
+	switch (op) {
+	case OP_MEMCPY:
+		(void)v->memcpy(dst, src, len);
+		break;
+	case OP_MEMMOVE:
+		(void)v->memmove(dst, src, len);
+		break;
+	case OP_MEMSET:
+		(void)v->memset(dst, 0xa5, len);
+		break;
+	case OP_MEMCMP:
+		sink = v->memcmp(dst, src, len);
+		break;
+	}
+}
+
+/*
+ * Runs one operation once on fresh buffers and compares the result with the
+ * one of the host C library. Returns 0 on success.
+ */
+static int check(const variant_t *v, op_t op, size_t dst_off, size_t src_off,
+		 size_t len)
+{
+	unsigned char *src = src_buf + src_off;
+	unsigned char *dst = dst_buf + dst_off;
+	unsigned char *ref = ref_buf + dst_off;
+	int ret;
+
+	fill(src_buf, sizeof(src_buf), 1U);
+	fill(dst_buf, sizeof(dst_buf), 2U);
+	fill(ref_buf, sizeof(ref_buf), 2U);
+
+	switch (op) {
+	case OP_MEMCPY:
+		(void)v->memcpy(dst, src, len);
+		(void)memcpy(ref, src, len);
+		break;
+	case OP_MEMMOVE:
+		src = dst_buf + src_off;
+		dst = dst_buf + BENCH_MOVE_DISTANCE + dst_off;
+		(void)v->memmove(dst, src, len);
+		(void)memmove(ref_buf + BENCH_MOVE_DISTANCE + dst_off,
+			      ref_buf + src_off, len);
+		break;
+	case OP_MEMSET:
+		(void)v->memset(dst, 0xa5, len);
+		(void)memset(ref, 0xa5, len);
+		break;
+	case OP_MEMCMP:
+		(void)memcpy(dst, src, len);
+		ret = v->memcmp(dst, src, len);
+		if (ret != 0)
+			return -1;
+		if (len == 0U)
+			return 0;
+		/* Make the last byte differ and check the sign. */
+		dst[len - 1U] = (unsigned char)(src[len - 1U] + 1U);
+		ret = v->memcmp(dst, src, len);
+		return (ret > 0) ? 0 : -1;
+	}
+
+	return (memcmp(dst_buf, ref_buf, sizeof(dst_buf)) == 0) ? 0 : -1;
+}
+
+/* Returns the throughput of an operation in megabytes per second. */
+static double measure(const variant_t *v, op_t op, size_t dst_off,
+		      size_t src_off, size_t len, unsigned long total)
+{
+	unsigned char *src = src_buf + src_off;
+	unsigned char *dst = dst_buf + dst_off;
+	unsigned long calls = total / len;
+	uint64_t start, elapsed;
+
+	if (op == OP_MEMMOVE) {
+		src = dst_buf + src_off;
+		dst = dst_buf + BENCH_MOVE_DISTANCE + dst_off;
+	} else if (op == OP_MEMCMP) {
+		(void)memcpy(dst, src, len);
+	}
+
+	/* Warm up the caches. */
+	run(v, op, dst, src, len);
+
+	start = now_ns();
+	for (unsigned long i = 0; i < calls; i++)
+		run(v, op, dst, src, len);
+	elapsed = now_ns() - start;
+
+	if (elapsed == 0U)
+		elapsed = 1U;
+
+	return ((double)calls * (double)len * 1000.0) / (double)elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long total = 64UL << 20;
+	int failures = 0;
+
+	if (argc > 1)
+		total = strtoul(argv[1], NULL, 0) << 20;
+
+	if (total == 0U) {
+		fprintf(stderr, "usage: %s [megabytes per measurement]\n",
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	for (op_t op = OP_MEMCPY; op <= OP_MEMCMP; op++) {
+		for (size_t a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+			for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+				for (size_t i = 0; i < NUM_VARIANTS; i++) {
+					if (check(&variants[i], op, aligns[a].dst,
+						  aligns[a].src, sizes[s]) == 0)
+						continue;
+					fprintf(stderr,
+						"%s %s: wrong result for size %zu, dst+%zu, src+%zu\n",
+						variants[i].name, op_names[op],
+						sizes[s], aligns[a].dst,
+						aligns[a].src);
+					failures++;
+				}
+			}
+		}
+	}
+
+	if (failures != 0)
+		return EXIT_FAILURE;
+
+	printf("%-8s %6s %7s", "function", "size", "dst/src");
+	for (size_t i = 0; i < NUM_VARIANTS; i++)
+		printf(" %9s", variants[i].name);
+	printf("   (MB/s)\n");
+
+	for (op_t op = OP_MEMCPY; op <= OP_MEMCMP; op++) {
+		for (size_t a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+			for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+				printf("%-8s %6zu %3zu/%-3zu", op_names[op],
+				       sizes[s], aligns[a].dst, aligns[a].src);
+				for (size_t i = 0; i < NUM_VARIANTS; i++)
+					printf(" %9.0f",
+					       measure(&variants[i], op,
+						       aligns[a].dst,
+						       aligns[a].src, sizes[s],
+						       total));
+				printf("\n");
+			}
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
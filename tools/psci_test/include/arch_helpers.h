@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+/*
+ * Replacement of the architectural helpers for the host, found before the
+ * ones of the firmware in the include path. Only the registers read by the
+ * PSCI library are provided, by psci_test_plat.c.
+ */
+#include <stdint.h>
+
+u_register_t read_tpidr_el3(void);
+u_register_t read_scr_el3(void);
+u_register_t read_sctlr_el1(void);
+u_register_t read_sctlr_el2(void);
+
+#endif /* ARCH_HELPERS_H */
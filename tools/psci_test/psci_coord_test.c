@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Contention test of the lock-free state coordination of PSCI. One thread per
+ * CPU suspends at the same time in each round, then wakes up. In half of the
+ * rounds, all the CPUs request the deepest power down state of the system;
+ * in the others, each CPU requests to power down up to a random level. After
+ * each round, the test checks that each cluster and the system were powered
+ * down by exactly one CPU if all of their CPUs requested it, and by none
+ * otherwise.
+ *
+ * Usage: psci_coord_test [rounds] [seed]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "platform_def.h"
+#include "psci_test.h"
+
+#define CLUSTER_PWR_LVL		1U
+#define SYSTEM_PWR_LVL		2U
+
+static unsigned long rounds;
+static unsigned long seed;
+static uint64_t rng_state;
+static __thread uint64_t preempt_rng_state;
+
+static pthread_barrier_t round_barrier;
+
+/* Power level each CPU suspends up to in the current round */
+static unsigned int round_end_pwrlvl[PLATFORM_CORE_COUNT];
+
+/* Results of the current round, and totals */
+static unsigned int cluster_pwrdowns[PLATFORM_CLUSTER_COUNT];
+static unsigned int system_pwrdowns;
+static unsigned long lockless_suspends;
+static unsigned long total_cluster_pwrdowns;
+static unsigned long total_system_pwrdowns;
+
+static uint64_t rng(uint64_t *state)
+{
+	/* xorshift64* */
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static void fail(const char *msg, unsigned long round)
+{
+	fprintf(stderr, "FAIL: %s in round %lu\n", msg, round);
+	exit(1);
+}
+
+/* Firmware services used by the library */
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	(void)vfprintf(stderr, fmt + 1, args);
+	va_end(args);
+}
+
+int console_flush(void)
+{
+	return 0;
+}
+
+void __attribute__((__noreturn__)) do_panic(void)
+{
+	fprintf(stderr, "FAIL: panic\n");
+	abort();
+}
+
+void __attribute__((__noreturn__)) __assert(const char *file,
+					    unsigned int line,
+					    const char *assertion)
+{
+	fprintf(stderr, "FAIL: assertion %s failed at %s:%u\n", assertion,
+		file, line);
+	abort();
+}
+
+void psci_test_spin(void)
+{
+	(void)sched_yield();
+}
+
+void psci_test_preempt(void)
+{
+	if ((rng(&preempt_rng_state) % 4U) == 0U)
+		(void)sched_yield();
+}
+
+static void plan_round(void)
+{
+	unsigned int cpu;
+	int deepest = (rng(&rng_state) % 2U) == 0U;
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		round_end_pwrlvl[cpu] = deepest ? PLAT_MAX_PWR_LVL :
+			(unsigned int)(rng(&rng_state) % (PLAT_MAX_PWR_LVL + 1));
+	}
+}
+
+static void check_round(unsigned long round)
+{
+	unsigned int cpu, cluster, expected;
+	unsigned int system_expected = 1U;
+
+	for (cluster = 0U; cluster < PLATFORM_CLUSTER_COUNT; cluster++) {
+		expected = 1U;
+		for (cpu = cluster * PLATFORM_MAX_CPUS_PER_CLUSTER;
+		     cpu < (cluster + 1U) * PLATFORM_MAX_CPUS_PER_CLUSTER;
+		     cpu++) {
+			if (round_end_pwrlvl[cpu] < CLUSTER_PWR_LVL)
+				expected = 0U;
+			if (round_end_pwrlvl[cpu] < SYSTEM_PWR_LVL)
+				system_expected = 0U;
+		}
+
+		if (cluster_pwrdowns[cluster] != expected)
+			fail(expected ? "cluster not powered down once" :
+			     "cluster powered down", round);
+
+		total_cluster_pwrdowns += cluster_pwrdowns[cluster];
+		cluster_pwrdowns[cluster] = 0U;
+	}
+
+	if (system_pwrdowns != system_expected)
+		fail(system_expected ? "system not powered down once" :
+		     "system powered down", round);
+
+	total_system_pwrdowns += system_pwrdowns;
+	system_pwrdowns = 0U;
+}
+
+static void *cpu_thread(void *arg)
+{
+	unsigned int cpu = (unsigned int)(uintptr_t)arg;
+	unsigned int cluster = cpu / PLATFORM_MAX_CPUS_PER_CLUSTER;
+	unsigned int end_pwrlvl, off_pwrlvl, lockless;
+	unsigned long round;
+
+	psci_test_set_cpu(cpu);
+	preempt_rng_state = (seed + 1U) * (cpu + 1U);
+
+	for (round = 0U; round < rounds; round++) {
+		(void)pthread_barrier_wait(&round_barrier);
+
+		end_pwrlvl = round_end_pwrlvl[cpu];
+		off_pwrlvl = psci_test_suspend(end_pwrlvl, &lockless);
+
+		if (lockless != 0U)
+			(void)__atomic_add_fetch(&lockless_suspends, 1U,
+						 __ATOMIC_RELAXED);
+		if (off_pwrlvl >= CLUSTER_PWR_LVL)
+			(void)__atomic_add_fetch(&cluster_pwrdowns[cluster],
+						 1U, __ATOMIC_RELAXED);
+		if (off_pwrlvl >= SYSTEM_PWR_LVL)
+			(void)__atomic_add_fetch(&system_pwrdowns, 1U,
+						 __ATOMIC_RELAXED);
+
+		(void)pthread_barrier_wait(&round_barrier);
+
+		/*
+		 * The other CPUs only read the plan and update the results
+		 * of the next round once this CPU reaches the first barrier.
+		 */
+		if (cpu == 0U) {
+			check_round(round);
+			plan_round();
+		}
+
+		psci_test_wake(end_pwrlvl);
+	}
+
+	return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	pthread_t threads[PLATFORM_CORE_COUNT];
+	unsigned int cpu;
+
+	rounds = (argc > 1) ? strtoul(argv[1], NULL, 0) : 20000UL;
+	seed = (argc > 2) ? strtoul(argv[2], NULL, 0) : 1UL;
+	rng_state = (seed == 0U) ? 1U : seed;
+
+	psci_test_init();
+	plan_round();
+
+	if (pthread_barrier_init(&round_barrier, NULL, PLATFORM_CORE_COUNT)
+	    != 0)
+		fail("cannot create the barrier", 0U);
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		if (pthread_create(&threads[cpu], NULL, cpu_thread,
+				   (void *)(uintptr_t)cpu) != 0)
+			fail("cannot create a thread", 0U);
+	}
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++)
+		(void)pthread_join(threads[cpu], NULL);
+
+	printf("%lu rounds, seed %lu: %lu system and %lu cluster power downs, "
+	       "%lu lockless suspends\n", rounds, seed, total_system_pwrdowns,
+	       total_cluster_pwrdowns, lockless_suspends);
+
+	return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PSCI_TEST_H
+#define PSCI_TEST_H
+
+/*
+ * Interface between the test program, built against the host C library, and
+ * psci_test_plat.c, built with the PSCI library against the headers of the
+ * firmware.
+ */
+
+/* psci_test_plat.c */
+void psci_test_init(void);
+void psci_test_set_cpu(unsigned int cpu_idx);
+unsigned int psci_test_suspend(unsigned int end_pwrlvl, unsigned int *lockless);
+void psci_test_wake(unsigned int end_pwrlvl);
+
+/*
+ * Test program: give the host CPU to another thread, always when spinning on a
+ * lock, and at random after an atomic operation, so that the threads also
+ * interleave between the atomic operations of the library on a host with few
+ * CPUs.
+ */
+void psci_test_spin(void);
+void psci_test_preempt(void);
+
+#endif /* PSCI_TEST_H */
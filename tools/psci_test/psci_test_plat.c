@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Replacement of the platform, of the architectural layer and of the assembly
+ * helpers used by the PSCI state coordination, so that it can run on the host
+ * with one thread per CPU. The power domain tree is the one psci_setup() would
+ * build from the topology of platform_def.h.
+ */
+
+#include <arch_helpers.h>
+#include <assert.h>
+#include <debug.h>
+#include <platform.h>
+#include <psci.h>
+#include <spinlock.h>
+#include <stdint.h>
+
+#include "psci_private.h"
+#include "psci_test.h"
+
+unsigned int psci_caps;
+
+static cpu_data_t fake_cpu_data[PLATFORM_CORE_COUNT];
+
+/* CPU that the calling thread plays */
+static __thread unsigned int fake_cpu_idx;
+
+u_register_t read_tpidr_el3(void)
+{
+	return (u_register_t)&fake_cpu_data[fake_cpu_idx];
+}
+
+u_register_t read_scr_el3(void)
+{
+	return 0U;
+}
+
+u_register_t read_sctlr_el1(void)
+{
+	return 0U;
+}
+
+u_register_t read_sctlr_el2(void)
+{
+	return 0U;
+}
+
+struct cpu_data *_cpu_data_by_index(uint32_t cpu_index)
+{
+	return &fake_cpu_data[cpu_index];
+}
+
+unsigned int plat_my_core_pos(void)
+{
+	return fake_cpu_idx;
+}
+
+int plat_core_pos_by_mpidr(u_register_t mpidr)
+{
+	return -1;
+}
+
+/* Same as the default of plat/common/plat_psci_common.c */
+plat_local_state_t plat_get_target_pwr_state(unsigned int lvl,
+					     const plat_local_state_t *states,
+					     unsigned int ncpu)
+{
+	plat_local_state_t target = PLAT_MAX_OFF_STATE;
+	unsigned int n;
+
+	assert(ncpu > 0U);
+
+	for (n = 0U; n < ncpu; n++) {
+		if (states[n] < target)
+			target = states[n];
+	}
+
+	return target;
+}
+
+void zeromem(void *mem, u_register_t length)
+{
+	unsigned char *p = mem;
+
+	while (length-- > 0U)
+		*p++ = 0U;
+}
+
+/* The tests do not turn CPUs on or power them down */
+void psci_cpu_on_finish(int cpu_idx, const psci_power_state_t *state_info)
+{
+	panic();
+}
+
+void psci_cpu_suspend_finish(int cpu_idx, const psci_power_state_t *state_info)
+{
+	panic();
+}
+
+void prepare_cpu_pwr_dwn(unsigned int power_level)
+{
+	panic();
+}
+
+/* lib/psci/aarch64/psci_helpers.S */
+unsigned int psci_atomic_add(unsigned int *count, int val)
+{
+	unsigned int ret;
+
+	ret = __atomic_add_fetch(count, (unsigned int)val, __ATOMIC_ACQ_REL);
+	psci_test_preempt();
+
+	return ret;
+}
+
+unsigned int psci_atomic_dec_unless_last(unsigned int *count)
+{
+	unsigned int old = __atomic_load_n(count, __ATOMIC_RELAXED);
+
+	do {
+		if (old <= 1U)
+			return 0U;
+	} while (!__atomic_compare_exchange_n(count, &old, old - 1U, false,
+					      __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+	psci_test_preempt();
+
+	return 1U;
+}
+
+/* lib/locks/exclusive/aarch64/spinlock.S */
+void spin_lock(spinlock_t *lock)
+{
+	while (__atomic_exchange_n(&lock->lock, 1U, __ATOMIC_ACQUIRE) != 0U)
+		psci_test_spin();
+}
+
+void spin_unlock(spinlock_t *lock)
+{
+	__atomic_store_n(&lock->lock, 0U, __ATOMIC_RELEASE);
+}
+
+/*
+ * Build the power domain tree, then bring all the CPUs up as the warm boot
+ * path does.
+ */
+void psci_test_init(void)
+{
+	unsigned int i, cluster;
+
+	psci_non_cpu_pd_nodes[0].level = PLAT_MAX_PWR_LVL;
+	/* The parent of the root node is -1, as set by psci_setup() */
+	psci_non_cpu_pd_nodes[0].parent_node = (unsigned int)-1;
+	psci_non_cpu_pd_nodes[0].cpu_start_idx = 0;
+	psci_non_cpu_pd_nodes[0].ncpus = PLATFORM_CORE_COUNT;
+
+	for (cluster = 0U; cluster < PLATFORM_CLUSTER_COUNT; cluster++) {
+		i = 1U + cluster;
+		psci_non_cpu_pd_nodes[i].level = PSCI_CPU_PWR_LVL + 1U;
+		psci_non_cpu_pd_nodes[i].parent_node = 0U;
+		psci_non_cpu_pd_nodes[i].cpu_start_idx =
+			(int)(cluster * PLATFORM_MAX_CPUS_PER_CLUSTER);
+		psci_non_cpu_pd_nodes[i].ncpus = PLATFORM_MAX_CPUS_PER_CLUSTER;
+	}
+
+	for (i = 0U; i < PSCI_NUM_NON_CPU_PWR_DOMAINS; i++) {
+		psci_lock_init(psci_non_cpu_pd_nodes, (unsigned char)i);
+		psci_non_cpu_pd_nodes[i].local_state = PLAT_MAX_OFF_STATE;
+	}
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		psci_cpu_pd_nodes[i].parent_node =
+			1U + (i / PLATFORM_MAX_CPUS_PER_CLUSTER);
+		psci_cpu_pd_nodes[i].mpidr = PSCI_INVALID_MPIDR;
+	}
+
+	psci_init_req_local_pwr_states();
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		psci_test_set_cpu(i);
+		psci_test_wake(PLAT_MAX_PWR_LVL);
+	}
+}
+
+void psci_test_set_cpu(unsigned int cpu_idx)
+{
+	assert(cpu_idx < PLATFORM_CORE_COUNT);
+	fake_cpu_idx = cpu_idx;
+}
+
+/*
+ * Request the deepest power down state up to 'end_pwrlvl', coordinated as by
+ * psci_cpu_suspend_start(). Returns the highest power level that is powered
+ * down, and in 'lockless' whether the locks were avoided.
+ */
+unsigned int psci_test_suspend(unsigned int end_pwrlvl, unsigned int *lockless)
+{
+	psci_power_state_t state_info;
+	int idx = (int)plat_my_core_pos();
+	unsigned int lvl;
+
+	for (lvl = PSCI_CPU_PWR_LVL; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		state_info.pwr_domain_state[lvl] = (lvl <= end_pwrlvl) ?
+			PLAT_MAX_OFF_STATE : PSCI_LOCAL_STATE_RUN;
+	}
+
+	*lockless = psci_lockless_state_coordination(end_pwrlvl, &state_info);
+	if (*lockless == 0U) {
+		psci_acquire_pwr_domain_locks(end_pwrlvl, idx);
+		psci_do_state_coordination(end_pwrlvl, &state_info);
+		psci_release_pwr_domain_locks(end_pwrlvl, idx);
+	}
+
+	return psci_find_max_off_lvl(&state_info);
+}
+
+/* Wake up from a suspend to 'end_pwrlvl', as psci_warmboot_entrypoint() */
+void psci_test_wake(unsigned int end_pwrlvl)
+{
+	int idx = (int)plat_my_core_pos();
+
+	psci_acquire_pwr_domain_locks(end_pwrlvl, idx);
+	psci_set_pwr_domains_to_run(end_pwrlvl);
+	psci_release_pwr_domain_locks(end_pwrlvl, idx);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "payload.h"
+
+/*
+ * PL011 UART of the QEMU virt platform, already initialised by the firmware.
+ * Only one core prints at a time, so no lock is needed.
+ */
+#define UART_BASE		0x09000000UL
+#define UARTDR			0x000
+#define UARTFR			0x018
+#define UARTFR_TXFF		(1U << 5)
+
+static void console_putc(char c)
+{
+	volatile uint32_t *fr = (volatile uint32_t *)(UART_BASE + UARTFR);
+	volatile uint32_t *dr = (volatile uint32_t *)(UART_BASE + UARTDR);
+
+	if (c == '\n')
+		console_putc('\r');
+
+	while ((*fr & UARTFR_TXFF) != 0U)
+		;
+	*dr = (uint32_t)(unsigned char)c;
+}
+
+static void print_padded(const char *s, unsigned int len, unsigned int width,
+			 char pad, int left)
+{
+	unsigned int i;
+
+	if (left == 0) {
+		for (i = len; i < width; i++)
+			console_putc(pad);
+	}
+
+	for (i = 0U; i < len; i++)
+		console_putc(s[i]);
+
+	if (left != 0) {
+		for (i = len; i < width; i++)
+			console_putc(' ');
+	}
+}
+
+static void print_number(uint64_t value, unsigned int base, int negative,
+			 unsigned int width, char pad, int left)
+{
+	char buf[24];
+	unsigned int pos = sizeof(buf);
+
+	do {
+		unsigned int digit = (unsigned int)(value % base);
+
+		buf[--pos] = (char)((digit < 10U) ? ('0' + digit) :
+						    ('a' + digit - 10U));
+		value /= base;
+	} while (value != 0U);
+
+	if (negative != 0)
+		buf[--pos] = '-';
+
+	print_padded(&buf[pos], sizeof(buf) - pos, width, pad, left);
+}
+
+/*
+ * Minimal printf() supporting %c, %s, %d, %u and %x, with the '-' and '0'
+ * flags, a field width and the 'l' and 'll' length modifiers.
+ */
+void payload_printf(const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+
+	for (; *fmt != '\0'; fmt++) {
+		unsigned int width = 0U, longs = 0U, len;
+		int left = 0;
+		char pad = ' ';
+		const char *s;
+		uint64_t value;
+		int64_t svalue;
+		char c;
+
+		if (*fmt != '%') {
+			console_putc(*fmt);
+			continue;
+		}
+
+		fmt++;
+		if (*fmt == '-') {
+			left = 1;
+			fmt++;
+		}
+		if (*fmt == '0') {
+			pad = '0';
+			fmt++;
+		}
+		while ((*fmt >= '0') && (*fmt <= '9'))
+			width = (width * 10U) + (unsigned int)(*fmt++ - '0');
+		while (*fmt == 'l') {
+			longs++;
+			fmt++;
+		}
+
+		switch (*fmt) {
+		case 'c':
+			c = (char)va_arg(args, int);
+			print_padded(&c, 1U, width, ' ', left);
+			break;
+		case 's':
+			s = va_arg(args, const char *);
+			for (len = 0U; s[len] != '\0'; len++)
+				;
+			print_padded(s, len, width, ' ', left);
+			break;
+		case 'd':
+			svalue = (longs != 0U) ? va_arg(args, int64_t) :
+						 va_arg(args, int);
+			print_number((svalue < 0) ? -(uint64_t)svalue :
+				     (uint64_t)svalue, 10U, svalue < 0,
+				     width, pad, left);
+			break;
+		case 'u':
+		case 'x':
+			value = (longs != 0U) ? va_arg(args, uint64_t) :
+						va_arg(args, unsigned int);
+			print_number(value, (*fmt == 'u') ? 10U : 16U, 0,
+				     width, pad, left);
+			break;
+		case '\0':
+			fmt--;
+			break;
+		default:
+			console_putc(*fmt);
+			break;
+		}
+	}
+
+	va_end(args);
+}
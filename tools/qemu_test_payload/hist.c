@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include "payload.h"
+
+/*
+ * Return the bin of a histogram of `count` values, one bin per value, within
+ * which `permille` of the values fall.
+ */
+uint64_t payload_percentile(const uint32_t *hist, unsigned int bins,
+			    uint64_t count, unsigned int permille)
+{
+	uint64_t target = ((count * permille) + 999U) / 1000U;
+	uint64_t sum = 0U;
+	unsigned int i;
+
+	for (i = 0U; i < bins; i++) {
+		sum += hist[i];
+		if (sum >= target)
+			break;
+	}
+
+	return i;
+}
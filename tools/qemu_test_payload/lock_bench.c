@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the time spent waiting for a lock in BL31 when all the cores take
+ * it at the same time. Each core issues SMC_BENCH_LOCK_64 LOCK_BENCH_ITERATIONS
+ * times, which takes and releases a spin lock or a ticket lock shared by all
+ * the CPUs, and counts the waiting times returned by BL31 in a histogram.
+ * Comparing the distribution of the cores shows how fair each lock is. It
+ * needs a BL31 built with ENABLE_SMC_BENCHMARK=1.
+ */
+
+#include <smc_bench.h>
+#include <stdint.h>
+
+#include "payload.h"
+
+#ifndef LOCK_BENCH_ITERATIONS
+#define LOCK_BENCH_ITERATIONS	100000U
+#endif
+
+/*
+ * One bin per tick. Waits of more ticks than the histogram covers are counted
+ * in its last bin.
+ */
+#define LOCK_BENCH_HIST_BINS	4096U
+
+/* Results of each core, written by the core and read by the primary core */
+static uint32_t hist[PAYLOAD_MAX_CORES][LOCK_BENCH_HIST_BINS];
+static uint64_t min_ticks[PAYLOAD_MAX_CORES];
+static uint64_t max_ticks[PAYLOAD_MAX_CORES];
+static unsigned int implemented[PAYLOAD_MAX_CORES];
+
+static void lock_bench_header(void)
+{
+	payload_printf("%u acquisitions per core, all cores at the same time, "
+		       "waiting times in ticks of the counter\n",
+		       LOCK_BENCH_ITERATIONS);
+	payload_printf("%-4s %-10s %8s %8s %8s %8s %8s\n", "core", "mpidr",
+		       "min", "median", "p90", "p99", "max");
+}
+
+static void lock_bench_run(unsigned int core, unsigned int lock)
+{
+	uint64_t ticks, min = UINT64_MAX, max = 0U;
+	uint32_t *core_hist = hist[core];
+	unsigned int n;
+	smc_ret_t ret;
+
+	ret = payload_smc(SMC_BENCH_LOCK_64, lock, 0U, 0U, 0U);
+	if ((uint32_t)ret.x0 == SMC_UNKNOWN) {
+		implemented[core] = 0U;
+		return;
+	}
+
+	for (n = 0U; n < LOCK_BENCH_HIST_BINS; n++)
+		core_hist[n] = 0U;
+
+	for (n = 0U; n < LOCK_BENCH_ITERATIONS; n++) {
+		ticks = payload_smc(SMC_BENCH_LOCK_64, lock, 0U, 0U, 0U).x1;
+		if (ticks < min)
+			min = ticks;
+		if (ticks > max)
+			max = ticks;
+		core_hist[(ticks < LOCK_BENCH_HIST_BINS) ? ticks :
+			  (LOCK_BENCH_HIST_BINS - 1U)]++;
+	}
+
+	min_ticks[core] = min;
+	max_ticks[core] = max;
+	implemented[core] = 1U;
+}
+
+static void lock_bench_report(unsigned int core, uint64_t mpidr)
+{
+	payload_printf("%-4u 0x%-8llx ", core, mpidr);
+
+	if (implemented[core] == 0U) {
+		payload_printf("not implemented\n");
+		return;
+	}
+
+	payload_printf("%8llu %8llu %8llu %8llu %8llu\n", min_ticks[core],
+		       payload_percentile(hist[core], LOCK_BENCH_HIST_BINS,
+					  LOCK_BENCH_ITERATIONS, 500U),
+		       payload_percentile(hist[core], LOCK_BENCH_HIST_BINS,
+					  LOCK_BENCH_ITERATIONS, 900U),
+		       payload_percentile(hist[core], LOCK_BENCH_HIST_BINS,
+					  LOCK_BENCH_ITERATIONS, 990U),
+		       max_ticks[core]);
+}
+
+static void spin_lock_bench_run(unsigned int core, uint64_t mpidr)
+{
+	lock_bench_run(core, SMC_BENCH_SPIN_LOCK);
+}
+
+static void ticket_lock_bench_run(unsigned int core, uint64_t mpidr)
+{
+	lock_bench_run(core, SMC_BENCH_TICKET_LOCK);
+}
+
+const payload_test_t spin_lock_bench_test = {
+	.name = "Spin lock contention",
+	.header = lock_bench_header,
+	.run = spin_lock_bench_run,
+	.report = lock_bench_report,
+};
+
+const payload_test_t ticket_lock_bench_test = {
+	.name = "Ticket lock contention",
+	.header = lock_bench_header,
+	.run = ticket_lock_bench_run,
+	.report = lock_bench_report,
+};
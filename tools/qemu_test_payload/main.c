@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "payload.h"
+
+#define MPIDR_AFFINITY_MASK	0xFFFFFFULL
+#define MPIDR_AFF1_SHIFT	8
+
+/* Time given to a secondary core to reach the payload, in seconds */
+#define CORE_START_TIMEOUT	1U
+
+static const payload_test_t *const tests[] = {
+	&smc_bench_test,
+	&runtime_stats_test,
+	&spin_lock_bench_test,
+	&ticket_lock_bench_test,
+};
+
+/*
+ * State shared with the secondary cores running a test. The payload runs
+ * with the MMU off, so these accesses are not cached.
+ */
+static const payload_test_t *volatile current_test;
+static volatile unsigned int core_started[PAYLOAD_MAX_CORES];
+static volatile unsigned int core_done[PAYLOAD_MAX_CORES];
+static volatile unsigned int cores_go;
+
+void payload_main(void);
+void payload_secondary_main(unsigned int core);
+
+void payload_secondary_main(unsigned int core)
+{
+	core_started[core] = 1U;
+	while (cores_go == 0U)
+		;
+
+	current_test->run(core, read_mpidr() & MPIDR_AFFINITY_MASK);
+	core_done[core] = 1U;
+
+	(void)payload_smc(PSCI_CPU_OFF, 0U, 0U, 0U, 0U);
+}
+
+static uint64_t core_mpidr(unsigned int core)
+{
+	return ((uint64_t)(core / PAYLOAD_MAX_CPUS_PER_CLUSTER) <<
+		MPIDR_AFF1_SHIFT) | (core % PAYLOAD_MAX_CPUS_PER_CLUSTER);
+}
+
+/*
+ * Power a secondary core on and wait until it reaches the payload. The
+ * topology of the platform may have more cores than QEMU emulates: those cores
+ * never start. Returns 0 if the core started.
+ */
+static int start_secondary(unsigned int core)
+{
+	uint64_t timeout;
+	smc_ret_t ret;
+
+	core_started[core] = 0U;
+	core_done[core] = 0U;
+
+	ret = payload_smc(PSCI_CPU_ON_AARCH64, core_mpidr(core),
+			  (uintptr_t)payload_secondary_entrypoint, core, 0U);
+	if ((int32_t)ret.x0 != PSCI_E_SUCCESS)
+		return -1;
+
+	timeout = read_cntvct() + (read_cntfrq() * CORE_START_TIMEOUT);
+	while (core_started[core] == 0U) {
+		if (read_cntvct() > timeout)
+			return -1;
+	}
+
+	return 0;
+}
+
+/* Wait until a started secondary core is done with the test and off again */
+static void wait_secondary(unsigned int core)
+{
+	smc_ret_t ret;
+
+	while (core_done[core] == 0U)
+		;
+
+	do {
+		ret = payload_smc(PSCI_AFFINITY_INFO_AARCH64, core_mpidr(core),
+				  0U, 0U, 0U);
+	} while ((int32_t)ret.x0 != PSCI_STATE_OFF);
+}
+
+/* Run the current test on each core in turn */
+static void run_in_turn(uint64_t self)
+{
+	unsigned int core;
+
+	cores_go = 1U;
+
+	for (core = 0U; core < PAYLOAD_MAX_CORES; core++) {
+		if (core_mpidr(core) == self) {
+			current_test->run(core, self);
+		} else if (start_secondary(core) == 0) {
+			wait_secondary(core);
+		}
+	}
+}
+
+/*
+ * Start all the cores, release them at once to run the current test, then
+ * report the results of each core once they are all done.
+ */
+static void run_on_all(uint64_t self)
+{
+	unsigned int present[PAYLOAD_MAX_CORES];
+	unsigned int core, self_core = 0U;
+
+	cores_go = 0U;
+
+	for (core = 0U; core < PAYLOAD_MAX_CORES; core++) {
+		if (core_mpidr(core) == self) {
+			self_core = core;
+			present[core] = 1U;
+		} else {
+			present[core] = (start_secondary(core) == 0) ? 1U : 0U;
+		}
+	}
+
+	cores_go = 1U;
+	current_test->run(self_core, self);
+
+	for (core = 0U; core < PAYLOAD_MAX_CORES; core++) {
+		if ((present[core] != 0U) && (core != self_core))
+			wait_secondary(core);
+	}
+
+	for (core = 0U; core < PAYLOAD_MAX_CORES; core++) {
+		if (present[core] != 0U)
+			current_test->report(core, core_mpidr(core));
+	}
+}
+
+void payload_main(void)
+{
+	uint64_t self = read_mpidr() & MPIDR_AFFINITY_MASK;
+	unsigned int i;
+
+	payload_printf("QEMU test payload at EL%u, counter at %llu Hz\n",
+		       read_current_el(), read_cntfrq());
+
+	for (i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		current_test = tests[i];
+
+		payload_printf("\n%s\n", current_test->name);
+		if (current_test->header != NULL)
+			current_test->header();
+
+		if (current_test->report != NULL)
+			run_on_all(self);
+		else
+			run_in_turn(self);
+	}
+
+	payload_printf("\nQEMU test payload: done\n");
+}
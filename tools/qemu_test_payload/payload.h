@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __PAYLOAD_H__
+#define __PAYLOAD_H__
+
+/*
+ * Topology of the QEMU virt platform of TF-A: the cores are numbered by
+ * cluster, then by core in the cluster, like plat_core_pos_by_mpidr().
+ */
+#define PAYLOAD_MAX_CLUSTERS		2
+#define PAYLOAD_MAX_CPUS_PER_CLUSTER	4
+#define PAYLOAD_MAX_CORES		(PAYLOAD_MAX_CLUSTERS * \
+					 PAYLOAD_MAX_CPUS_PER_CLUSTER)
+
+#define PAYLOAD_STACK_SIZE		0x1000
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+/* Function IDs of the standard calls used by the payload */
+#define PSCI_VERSION			0x84000000U
+#define PSCI_CPU_OFF			0x84000002U
+#define PSCI_CPU_ON_AARCH64		0xC4000003U
+#define PSCI_AFFINITY_INFO_AARCH64	0xC4000004U
+#define PSCI_E_SUCCESS			0
+#define PSCI_STATE_OFF			1
+#define SDEI_VERSION			0xC4000020U
+
+/* Value returned in x0 by unknown SMCs, as a 32-bit value */
+#define SMC_UNKNOWN			0xFFFFFFFFU
+
+typedef struct smc_ret {
+	uint64_t x0;
+	uint64_t x1;
+	uint64_t x2;
+	uint64_t x3;
+} smc_ret_t;
+
+/* helpers.S */
+smc_ret_t payload_smc(uint64_t fid, uint64_t x1, uint64_t x2, uint64_t x3,
+		      uint64_t x4);
+uint64_t payload_smc_ticks(uint64_t fid, uint64_t x1);
+uint64_t read_cntvct(void);
+uint64_t read_cntfrq(void);
+uint64_t read_mpidr(void);
+unsigned int read_current_el(void);
+void payload_secondary_entrypoint(void);
+
+/* console.c */
+void payload_printf(const char *fmt, ...)
+	__attribute__((__format__(__printf__, 1, 2)));
+
+/* hist.c */
+uint64_t payload_percentile(const uint32_t *hist, unsigned int bins,
+			    uint64_t count, unsigned int permille);
+
+/*
+ * A test run on each core in turn. The header, if any, is printed once by the
+ * primary core before the test is run. If the test has a report function, it
+ * is instead run on all the cores at the same time, and the primary core then
+ * calls report() to print the results of each core.
+ */
+typedef struct payload_test {
+	const char *name;
+	void (*header)(void);
+	void (*run)(unsigned int core, uint64_t mpidr);
+	void (*report)(unsigned int core, uint64_t mpidr);
+} payload_test_t;
+
+extern const payload_test_t smc_bench_test;
+extern const payload_test_t runtime_stats_test;
+extern const payload_test_t spin_lock_bench_test;
+extern const payload_test_t ticket_lock_bench_test;
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* __PAYLOAD_H__ */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Prints the runtime statistics that BL31 keeps for each core, read with the
+ * RUNTIME_STATS_SMC_GET_64 and RUNTIME_STATS_HIST_GET_64 SiP calls. It needs
+ * a BL31 built with ENABLE_RUNTIME_STATS=1. It runs after the SMC round trip
+ * test, so the statistics include the calls of that test.
+ */
+
+#include <runtime_stats.h>
+#include <stdint.h>
+
+#include "payload.h"
+
+/*
+ * The statistics of SMCs are kept by index in rt_svc_descs_indices, made of
+ * the OEN and, above it, the call type.
+ */
+#define RT_SVC_INDICES		128U
+#define RT_SVC_OEN_MASK		0x3FU
+#define RT_SVC_TYPE_SHIFT	6
+
+static const char *const intr_type_names[] = { "S-EL1", "EL3", "NS" };
+
+#define NUM_INTR_TYPES		(sizeof(intr_type_names) / \
+				 sizeof(intr_type_names[0]))
+
+static void runtime_stats_header(void)
+{
+	payload_printf("Times in ticks of the counter\n");
+	payload_printf("%-4s %-10s %-16s %10s %8s %8s  %s\n", "core", "mpidr",
+		       "event", "count", "mean", "max", "bucket:count");
+}
+
+static void print_event(unsigned int kind, unsigned int index)
+{
+	switch (kind) {
+	case RUNTIME_STATS_SMC:
+		payload_printf("SMC OEN %2u %-5s", index & RT_SVC_OEN_MASK,
+			       ((index >> RT_SVC_TYPE_SHIFT) != 0U) ?
+			       "fast" : "yield");
+		break;
+	case RUNTIME_STATS_INTR_TYPE:
+		payload_printf("intr type %-6s", intr_type_names[index]);
+		break;
+	default:
+		payload_printf("intr ID %-8u", index);
+		break;
+	}
+}
+
+/*
+ * Print the statistics of one entry, if it counted any event. Returns -1 if
+ * BL31 rejects the entry, which is past the last one of its kind.
+ */
+static int print_entry(unsigned int core, uint64_t mpidr, unsigned int kind,
+		       unsigned int index)
+{
+	unsigned int bucket;
+	smc_ret_t ret, hist;
+
+	ret = payload_smc(RUNTIME_STATS_SMC_GET_64, mpidr, kind, index, 0U);
+	if ((int64_t)ret.x0 < 0)
+		return -1;
+
+	if (ret.x1 == 0U)
+		return 0;
+
+	payload_printf("%-4u 0x%-8llx ", core, mpidr);
+	print_event(kind, index);
+	payload_printf(" %10llu %8llu %8llu ", ret.x1, ret.x2 / ret.x1,
+		       ret.x3);
+
+	for (bucket = 0U; bucket < RUNTIME_STATS_HIST_BUCKETS; bucket++) {
+		hist = payload_smc(RUNTIME_STATS_HIST_GET_64, mpidr, kind,
+				   index, bucket);
+		if (((int64_t)hist.x0 == 0) && (hist.x1 != 0U))
+			payload_printf(" %u:%llu", bucket, hist.x1);
+	}
+
+	payload_printf("\n");
+
+	return 0;
+}
+
+static void runtime_stats_run(unsigned int core, uint64_t mpidr)
+{
+	unsigned int i;
+	smc_ret_t ret;
+
+	ret = payload_smc(RUNTIME_STATS_SMC_GET_64, mpidr, RUNTIME_STATS_SMC,
+			  0U, 0U);
+	if ((uint32_t)ret.x0 == SMC_UNKNOWN) {
+		payload_printf("%-4u 0x%-8llx not implemented\n", core, mpidr);
+		return;
+	}
+
+	for (i = 0U; i < RT_SVC_INDICES; i++)
+		(void)print_entry(core, mpidr, RUNTIME_STATS_SMC, i);
+
+	for (i = 0U; i < NUM_INTR_TYPES; i++)
+		(void)print_entry(core, mpidr, RUNTIME_STATS_INTR_TYPE, i);
+
+	/* The number of interrupt IDs counted depends on the platform */
+	for (i = 0U; print_entry(core, mpidr, RUNTIME_STATS_INTR_ID, i) == 0;
+	     i++)
+		;
+}
+
+const payload_test_t runtime_stats_test = {
+	.name = "Runtime statistics",
+	.header = runtime_stats_header,
+	.run = runtime_stats_run,
+};
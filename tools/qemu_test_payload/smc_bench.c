@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the round trip of SMCs to BL31 on each core. Each call is issued
+ * SMC_BENCH_ITERATIONS times and its duration, read from the virtual counter,
+ * is counted in a histogram from which the median and the 99th percentile are
+ * taken. SMC_BENCH_NULL_64 needs a BL31 built with ENABLE_SMC_BENCHMARK=1 and
+ * SDEI_VERSION one built with SDEI_SUPPORT=1. Calls that BL31 does not
+ * implement are reported as such.
+ */
+
+#include <arm_arch_svc.h>
+#include <smc_bench.h>
+#include <stdint.h>
+
+#include "payload.h"
+
+#ifndef SMC_BENCH_ITERATIONS
+#define SMC_BENCH_ITERATIONS	1000000U
+#endif
+
+/*
+ * One bin per tick. Round trips of more ticks than the histogram covers are
+ * counted in its last bin.
+ */
+#define SMC_BENCH_HIST_BINS	4096U
+
+static const struct smc_bench_call {
+	const char *name;
+	uint32_t fid;
+	uint64_t x1;
+} calls[] = {
+	{ "SMC_BENCH_NULL_64", SMC_BENCH_NULL_64, 0U },
+	{ "PSCI_VERSION", PSCI_VERSION, 0U },
+	{ "SMCCC_ARCH_FEATURES", SMCCC_ARCH_FEATURES, SMCCC_ARCH_WORKAROUND_1 },
+	{ "SDEI_VERSION", SDEI_VERSION, 0U },
+};
+
+static uint32_t hist[SMC_BENCH_HIST_BINS];
+
+static void smc_bench_header(void)
+{
+	payload_printf("%u calls per function, in ticks of the counter\n",
+		       SMC_BENCH_ITERATIONS);
+	payload_printf("%-4s %-10s %-20s %8s %8s %8s %8s\n", "core", "mpidr",
+		       "function", "min", "median", "p99", "max");
+}
+
+static void smc_bench_run(unsigned int core, uint64_t mpidr)
+{
+	unsigned int i, n;
+
+	for (i = 0U; i < (sizeof(calls) / sizeof(calls[0])); i++) {
+		const struct smc_bench_call *call = &calls[i];
+		uint64_t ticks, min = UINT64_MAX, max = 0U;
+		smc_ret_t ret;
+
+		payload_printf("%-4u 0x%-8llx %-20s ", core, mpidr, call->name);
+
+		ret = payload_smc(call->fid, call->x1, 0U, 0U, 0U);
+		if ((uint32_t)ret.x0 == SMC_UNKNOWN) {
+			payload_printf("not implemented\n");
+			continue;
+		}
+
+		for (n = 0U; n < SMC_BENCH_HIST_BINS; n++)
+			hist[n] = 0U;
+
+		for (n = 0U; n < SMC_BENCH_ITERATIONS; n++) {
+			ticks = payload_smc_ticks(call->fid, call->x1);
+			if (ticks < min)
+				min = ticks;
+			if (ticks > max)
+				max = ticks;
+			hist[(ticks < SMC_BENCH_HIST_BINS) ? ticks :
+			     (SMC_BENCH_HIST_BINS - 1U)]++;
+		}
+
+		payload_printf("%8llu %8llu %8llu %8llu\n", min,
+			       payload_percentile(hist, SMC_BENCH_HIST_BINS,
+						  SMC_BENCH_ITERATIONS, 500U),
+			       payload_percentile(hist, SMC_BENCH_HIST_BINS,
+						  SMC_BENCH_ITERATIONS, 990U),
+			       max);
+	}
+}
+
+const payload_test_t smc_bench_test = {
+	.name = "SMC round trip",
+	.header = smc_bench_header,
+	.run = smc_bench_run,
+};
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/*
+ * Platform definitions needed to build the translation tables library on the
+ * host. The test programs register their own contexts, so these only need to
+ * be valid values.
+ */
+#define PLAT_VIRT_ADDR_SPACE_SIZE	(1ULL << 40)
+#define PLAT_PHY_ADDR_SPACE_SIZE	(1ULL << 40)
+#define MAX_XLAT_TABLES			64
+#define MAX_MMAP_REGIONS		1100
+#define CACHE_WRITEBACK_GRANULE		64
+
+#endif /* PLATFORM_DEF_H */
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the time it takes to register a number of static regions and to
+ * build the translation tables from them with init_xlat_tables_ctx(). Half of
+ * the regions are mapped with 2MB blocks and the other half with pages, each
+ * one in a different 2MB slot of the address space, and they are added in a
+ * random order. The deepest lookup level used by the resulting translation
+ * tables is reported along with the number of tables.
+ *
+ * Usage: xlat_tables_bench [iterations]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <xlat_tables_defs.h>
+#include <xlat_tables_v2.h>
+
+#include "xlat_tables_private.h"
+
+#define BENCH_VA_BASE		0x40000000UL
+#define BENCH_PA_OFFSET		0x100000000ULL
+
+#define BENCH_MAX_REGIONS	1000
+#define BENCH_MAX_TABLES	(BENCH_MAX_REGIONS / 2 + 16)
+
+REGISTER_XLAT_CONTEXT2(bench, BENCH_MAX_REGIONS, BENCH_MAX_TABLES,
+		       1ULL << 40, 1ULL << 40, EL3_REGIME, "xlat_table");
+
+static const int region_counts[] = { 100, 250, 500, 1000 };
+
+static mmap_region_t regions[BENCH_MAX_REGIONS];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void make_regions(int count)
+{
+	unsigned int seed = 1U;
+
+	for (int i = 0; i < count; i++) {
+		uintptr_t va = BENCH_VA_BASE + (uintptr_t)i * XLAT_BLOCK_SIZE(2U);
+		size_t size = ((i % 2) != 0) ? XLAT_BLOCK_SIZE(2U) :
+				(size_t)(1 + (i % 16)) * PAGE_SIZE;
+
+		regions[i] = (mmap_region_t)MAP_REGION(va + BENCH_PA_OFFSET, va,
+					size, MT_MEMORY | MT_RW | MT_SECURE);
+	}
+
+	/* Shuffle the regions so that they aren't added in order. */
+	for (int i = count - 1; i > 0; i--) {
+		int j = rand_r(&seed) % (i + 1);
+		mmap_region_t tmp = regions[i];
+
+		regions[i] = regions[j];
+		regions[j] = tmp;
+	}
+}
+
+/* Brings the context back to the state it had before any region was added. */
+static void reset_ctx(xlat_ctx_t *ctx)
+{
+	(void)memset(ctx->mmap, 0,
+		     sizeof(mmap_region_t) * (size_t)(ctx->mmap_num + 1));
+	ctx->next_table = 0;
+	ctx->max_va = 0U;
+	ctx->max_pa = 0U;
+	ctx->initialized = false;
+}
+
+/*
+ * Walks a translation table and its sub-tables, and returns the deepest level
+ * at which a block or page descriptor is found, or 0 if none is.
+ */
+static unsigned int max_level(const uint64_t *table, unsigned int entries,
+			      unsigned int level)
+{
+	unsigned int deepest = 0U;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		uint64_t type = table[i] & DESC_MASK;
+		unsigned int l = level;
+
+		if (type == INVALID_DESC)
+			continue;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) && (type == TABLE_DESC))
+			l = max_level((const uint64_t *)(uintptr_t)
+					(table[i] & TABLE_ADDR_MASK),
+				      XLAT_TABLE_ENTRIES, level + 1U);
+
+		if (l > deepest)
+			deepest = l;
+	}
+
+	return deepest;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+	xlat_ctx_t *ctx = &bench_xlat_ctx;
+	int iterations = (argc > 1) ? atoi(argv[1]) : 20;
+	uint64_t *add_ns, *init_ns;
+
+	if (iterations <= 0)
+		iterations = 1;
+
+	add_ns = calloc((size_t)iterations, sizeof(uint64_t));
+	init_ns = calloc((size_t)iterations, sizeof(uint64_t));
+	if ((add_ns == NULL) || (init_ns == NULL))
+		return 1;
+
+	printf("Median of %d iterations\n", iterations);
+	printf("%8s %14s %14s %8s %10s\n", "regions", "mmap_add (us)",
+	       "init (us)", "tables", "max level");
+
+	for (size_t n = 0U; n < ARRAY_SIZE(region_counts); n++) {
+		int count = region_counts[n];
+
+		make_regions(count);
+
+		for (int it = 0; it < iterations; it++) {
+			uint64_t t0, t1, t2;
+
+			reset_ctx(ctx);
+
+			t0 = now_ns();
+			for (int i = 0; i < count; i++)
+				mmap_add_region_ctx(ctx, &regions[i]);
+			t1 = now_ns();
+			init_xlat_tables_ctx(ctx);
+			t2 = now_ns();
+
+			add_ns[it] = t1 - t0;
+			init_ns[it] = t2 - t1;
+		}
+
+		qsort(add_ns, (size_t)iterations, sizeof(uint64_t), cmp_u64);
+		qsort(init_ns, (size_t)iterations, sizeof(uint64_t), cmp_u64);
+
+		int used_tables = 0;
+
+		for (int i = 0; i < ctx->tables_num; i++) {
+			if (ctx->tables_mapped_regions[i] != 0)
+				used_tables++;
+		}
+
+		printf("%8d %14.1f %14.1f %8d %10u\n", count,
+		       (double)add_ns[iterations / 2] / 1000.0,
+		       (double)init_ns[iterations / 2] / 1000.0, used_tables,
+		       max_level(ctx->base_table, ctx->base_table_entries,
+				 ctx->base_level));
+	}
+
+	free(add_ns);
+	free(init_ns);
+
+	return 0;
+}
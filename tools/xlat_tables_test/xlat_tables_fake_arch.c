@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Replacement of lib/xlat_tables_v2/${ARCH}/xlat_tables_arch.c and of the
+ * few firmware services used by the library, so that it can run on the host.
+ * The translation tables are only ever written to memory, so there is nothing
+ * to invalidate or to clean.
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <xlat_tables_v2.h>
+
+#include "xlat_tables_fake_arch.h"
+#include "xlat_tables_private.h"
+
+unsigned long fake_tlbi_count;
+unsigned long fake_clean_dcache_count;
+
+bool is_mmu_enabled_ctx(const xlat_ctx_t *ctx)
+{
+	return ctx->initialized;
+}
+
+bool is_dcache_enabled(void)
+{
+	return true;
+}
+
+unsigned long long xlat_arch_get_max_supported_pa(void)
+{
+	return (1ULL << 40) - 1ULL;
+}
+
+uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
+{
+	return UPPER_ATTRS(XN);
+}
+
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	fake_tlbi_count++;
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	fake_tlbi_count++;
+}
+
+void xlat_arch_tlbi_va_sync(void)
+{
+}
+
+void xlat_arch_tables_sync(void)
+{
+}
+
+void xlat_arch_clean_dcache_range(uintptr_t addr, size_t size)
+{
+	fake_clean_dcache_count++;
+}
+
+/* Only errors and warnings are printed, skipping the LOG_MARKER_* prefix. */
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	if ((unsigned int)fmt[0] > 30U)
+		return;
+
+	va_start(args, fmt);
+	(void)vfprintf(stderr, fmt + 1, args);
+	va_end(args);
+}
+
+int console_flush(void)
+{
+	return 0;
+}
+
+void do_panic(void)
+{
+	fprintf(stderr, "PANIC\n");
+	abort();
+}
+
+/* Signature used with ENABLE_ASSERTIONS=1 and LOG_LEVEL=40 */
+void __assert(const char *file, unsigned int line)
+{
+	fprintf(stderr, "ASSERT: %s:%u\n", file, line);
+	abort();
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef XLAT_TABLES_FAKE_ARCH_H
+#define XLAT_TABLES_FAKE_ARCH_H
+
+/*
+ * Number of times that the library has asked the fake architectural layer to
+ * invalidate TLB entries and to clean the data cache.
+ */
+extern unsigned long fake_tlbi_count;
+extern unsigned long fake_clean_dcache_count;
+
+#endif /* XLAT_TABLES_FAKE_ARCH_H */
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Randomized test of the dynamic regions of the translation tables library.
+ * Regions are added and removed at random in a window of the address space,
+ * and after every operation the translation tables are walked and compared
+ * against a page-level model of what should be mapped.
+ *
+ * Usage: xlat_tables_stress [operations] [seed]
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xlat_tables_defs.h>
+#include <xlat_tables_v2.h>
+
+#include "xlat_tables_fake_arch.h"
+#include "xlat_tables_private.h"
+
+#define TEST_VA_BASE		0x40000000UL
+#define TEST_PA_BASE		0x80000000ULL
+#define TEST_WINDOW_SIZE	0x4000000UL
+#define TEST_WINDOW_PAGES	(TEST_WINDOW_SIZE / PAGE_SIZE)
+
+#define TEST_MAX_REGIONS	64
+#define TEST_STATIC_REGIONS	4
+
+/*
+ * Few enough tables to run out of them from time to time, which exercises the
+ * error path of mmap_add_dynamic_region_ctx().
+ */
+#define TEST_MAX_TABLES		24
+
+REGISTER_XLAT_CONTEXT2(stress, TEST_MAX_REGIONS, TEST_MAX_TABLES,
+		       1ULL << 40, 1ULL << 40, EL3_REGIME, "xlat_table");
+
+/* Expected state of each page of the window. */
+struct page_model {
+	bool mapped;
+	unsigned long long pa;
+	unsigned int attr;
+};
+
+static struct page_model va_model[TEST_WINDOW_PAGES];
+static bool pa_used[TEST_WINDOW_PAGES];
+
+/* Dynamic regions currently mapped. */
+static mmap_region_t dyn_regions[TEST_MAX_REGIONS];
+static int dyn_count;
+
+static uint64_t rng_state;
+
+static uint64_t rng(void)
+{
+	/* xorshift64* */
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static unsigned long rng_range(unsigned long n)
+{
+	return (unsigned long)(rng() % n);
+}
+
+static void fail(const char *msg, uintptr_t va)
+{
+	fprintf(stderr, "FAIL: %s at VA 0x%lx\n", msg, (unsigned long)va);
+	exit(1);
+}
+
+/* Generates a random region of up to 8MB inside the window. */
+static mmap_region_t random_region(void)
+{
+	static const unsigned int types[] = {
+		MT_MEMORY, MT_DEVICE, MT_NON_CACHEABLE
+	};
+	size_t pages;
+	unsigned long va_page, pa_page;
+	unsigned int attr;
+
+	if (rng_range(4U) == 0U) {
+		/* 2MB aligned region that can be mapped with blocks. */
+		pages = (1U + rng_range(4U)) * (XLAT_BLOCK_SIZE(2U) / PAGE_SIZE);
+		va_page = rng_range(TEST_WINDOW_SIZE / XLAT_BLOCK_SIZE(2U)) *
+			  (XLAT_BLOCK_SIZE(2U) / PAGE_SIZE);
+		pa_page = rng_range(TEST_WINDOW_SIZE / XLAT_BLOCK_SIZE(2U)) *
+			  (XLAT_BLOCK_SIZE(2U) / PAGE_SIZE);
+	} else {
+		pages = 1U + rng_range((rng_range(8U) == 0U) ? 2048U : 64U);
+		va_page = rng_range(TEST_WINDOW_PAGES);
+		pa_page = rng_range(TEST_WINDOW_PAGES);
+	}
+
+	if (va_page + pages > TEST_WINDOW_PAGES)
+		va_page = TEST_WINDOW_PAGES - pages;
+	if (pa_page + pages > TEST_WINDOW_PAGES)
+		pa_page = TEST_WINDOW_PAGES - pages;
+
+	attr = types[rng_range(3U)];
+	attr |= (rng_range(2U) == 0U) ? MT_RO : MT_RW;
+	attr |= (rng_range(2U) == 0U) ? MT_SECURE : MT_NS;
+	attr |= MT_EXECUTE_NEVER;
+
+	mmap_region_t mm = MAP_REGION(TEST_PA_BASE + pa_page * PAGE_SIZE,
+				      TEST_VA_BASE + va_page * PAGE_SIZE,
+				      pages * PAGE_SIZE, attr);
+	return mm;
+}
+
+static bool model_is_free(const mmap_region_t *mm)
+{
+	unsigned long va_page = (mm->base_va - TEST_VA_BASE) / PAGE_SIZE;
+	unsigned long pa_page = (mm->base_pa - TEST_PA_BASE) / PAGE_SIZE;
+
+	for (unsigned long i = 0U; i < mm->size / PAGE_SIZE; i++) {
+		if (va_model[va_page + i].mapped || pa_used[pa_page + i])
+			return false;
+	}
+
+	return true;
+}
+
+static void model_set(const mmap_region_t *mm, bool mapped)
+{
+	unsigned long va_page = (mm->base_va - TEST_VA_BASE) / PAGE_SIZE;
+	unsigned long pa_page = (mm->base_pa - TEST_PA_BASE) / PAGE_SIZE;
+
+	for (unsigned long i = 0U; i < mm->size / PAGE_SIZE; i++) {
+		va_model[va_page + i].mapped = mapped;
+		va_model[va_page + i].pa = mm->base_pa + i * PAGE_SIZE;
+		va_model[va_page + i].attr = mm->attr;
+		pa_used[pa_page + i] = mapped;
+	}
+}
+
+/*
+ * Walks the translation tables of the context to find the descriptor that
+ * maps the given VA. Returns 0 if the VA isn't mapped, and the descriptor and
+ * the PA otherwise.
+ */
+static uint64_t walk(const xlat_ctx_t *ctx, uintptr_t va,
+		     unsigned long long *pa)
+{
+	const uint64_t *table = ctx->base_table;
+	unsigned int entries = ctx->base_table_entries;
+
+	for (unsigned int level = ctx->base_level;
+	     level <= XLAT_TABLE_LEVEL_MAX; level++) {
+		unsigned int idx = (unsigned int)(va >> XLAT_ADDR_SHIFT(level)) &
+				   (entries - 1U);
+		uint64_t desc = table[idx];
+		uint64_t type = desc & DESC_MASK;
+
+		if (type == INVALID_DESC)
+			return 0U;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) && (type == TABLE_DESC)) {
+			table = (const uint64_t *)(uintptr_t)
+					(desc & TABLE_ADDR_MASK);
+			entries = XLAT_TABLE_ENTRIES;
+			continue;
+		}
+
+		if ((level == XLAT_TABLE_LEVEL_MAX) && (type != PAGE_DESC))
+			fail("reserved descriptor", va);
+		if ((level < 1U) && (type == BLOCK_DESC))
+			fail("level 0 block descriptor", va);
+
+		*pa = (desc & TABLE_ADDR_MASK & ~(XLAT_BLOCK_SIZE(level) - 1U)) |
+		      (va & (XLAT_BLOCK_SIZE(level) - 1U));
+		return desc;
+	}
+
+	fail("walk past the last level", va);
+	return 0U;
+}
+
+static void check_tables(const xlat_ctx_t *ctx)
+{
+	for (unsigned long i = 0U; i < TEST_WINDOW_PAGES; i++) {
+		uintptr_t va = TEST_VA_BASE + i * PAGE_SIZE;
+		const struct page_model *m = &va_model[i];
+		unsigned long long pa = 0U;
+		uint64_t desc = walk(ctx, va, &pa);
+		uint64_t attr_idx;
+
+		if (!m->mapped) {
+			if (desc != 0U)
+				fail("unexpected mapping", va);
+			continue;
+		}
+
+		if (desc == 0U)
+			fail("missing mapping", va);
+		if (pa != m->pa)
+			fail("wrong PA", va);
+
+		switch (MT_TYPE(m->attr)) {
+		case MT_DEVICE:
+			attr_idx = ATTR_DEVICE_INDEX;
+			break;
+		case MT_NON_CACHEABLE:
+			attr_idx = ATTR_NON_CACHEABLE_INDEX;
+			break;
+		default:
+			attr_idx = ATTR_IWBWA_OWBWA_NTR_INDEX;
+			break;
+		}
+		if (((desc >> 2) & 0x7U) != attr_idx)
+			fail("wrong memory type", va);
+
+		bool ro = (m->attr & MT_RW) == 0U;
+		if (((desc & LOWER_ATTRS(AP_RO)) != 0U) != ro)
+			fail("wrong access permissions", va);
+
+		bool ns = (m->attr & MT_NS) != 0U;
+		if (((desc & LOWER_ATTRS(NS)) != 0U) != ns)
+			fail("wrong security state", va);
+	}
+}
+
+static void add_static_regions(xlat_ctx_t *ctx)
+{
+	for (int i = 0; i < TEST_STATIC_REGIONS; i++) {
+		mmap_region_t mm = random_region();
+
+		if (!model_is_free(&mm))
+			continue;
+
+		mmap_add_region_ctx(ctx, &mm);
+		model_set(&mm, true);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	xlat_ctx_t *ctx = &stress_xlat_ctx;
+	unsigned long ops = (argc > 1) ? strtoul(argv[1], NULL, 0) : 20000UL;
+	unsigned long seed = (argc > 2) ? strtoul(argv[2], NULL, 0) : 1UL;
+	unsigned long added = 0U, removed = 0U, eperm = 0U, enomem = 0U;
+	int ret;
+
+	rng_state = (seed == 0U) ? 1U : seed;
+
+	add_static_regions(ctx);
+	init_xlat_tables_ctx(ctx);
+	check_tables(ctx);
+
+	for (unsigned long op = 0U; op < ops; op++) {
+		if ((dyn_count > 0) && (rng_range(5U) < 2U)) {
+			/* Remove a random dynamic region. */
+			int i = (int)rng_range((unsigned long)dyn_count);
+			mmap_region_t mm = dyn_regions[i];
+
+			ret = mmap_remove_dynamic_region_ctx(ctx, mm.base_va,
+							     mm.size);
+			if (ret != 0)
+				fail("failed to remove region", mm.base_va);
+
+			model_set(&mm, false);
+			dyn_regions[i] = dyn_regions[--dyn_count];
+			removed++;
+		} else if (rng_range(20U) == 0U) {
+			/* Remove a region that doesn't exist or is static. */
+			mmap_region_t mm = random_region();
+			int expected = -EINVAL;
+
+			for (const mmap_region_t *m = ctx->mmap;
+			     m->size != 0U; m++) {
+				if ((m->base_va == mm.base_va) &&
+				    (m->size == mm.size))
+					expected = ((m->attr & MT_DYNAMIC) != 0U) ?
+						   0 : -EPERM;
+			}
+			if (expected == 0)
+				continue;
+
+			ret = mmap_remove_dynamic_region_ctx(ctx, mm.base_va,
+							     mm.size);
+			if (ret != expected)
+				fail("unexpected removal result", mm.base_va);
+		} else {
+			/* Add a random dynamic region. */
+			mmap_region_t mm = random_region();
+			bool free = model_is_free(&mm);
+			bool full = ctx->mmap[ctx->mmap_num - 1].size != 0U;
+
+			ret = mmap_add_dynamic_region_ctx(ctx, &mm);
+			if (ret == 0) {
+				if (!free || full)
+					fail("overlapping region added",
+					     mm.base_va);
+				model_set(&mm, true);
+				dyn_regions[dyn_count++] = mm;
+				added++;
+			} else if (ret == -EPERM) {
+				if (free)
+					fail("free region rejected",
+					     mm.base_va);
+				eperm++;
+			} else if (ret == -ENOMEM) {
+				/* Out of mmap entries or of tables. */
+				enomem++;
+			} else {
+				fail("unexpected error", mm.base_va);
+			}
+		}
+
+		check_tables(ctx);
+	}
+
+	printf("%lu operations, seed %lu: %lu added, %lu removed, "
+	       "%lu overlapping, %lu out of memory\n",
+	       ops, seed, added, removed, eperm, enomem);
+	printf("%lu TLB invalidations, %lu data cache cleans\n",
+	       fake_tlbi_count, fake_clean_dcache_count);
+
+	return 0;
+}